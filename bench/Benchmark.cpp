@@ -0,0 +1,381 @@
+#include "ResourceManager.hpp"
+#include "EventManager.hpp"
+#include "CalendarView.hpp"
+#include "EventCodec.hpp"
+#include "TextStore.hpp"
+#include "PagedStore.hpp"
+#include "SqliteStore.hpp"
+#include "outils.hpp"
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+#include <cstdlib>
+
+struct BenchmarkResult {
+    std::string name;
+    unsigned int resource_count;
+    unsigned int event_count;
+    unsigned long iterations;
+    double nanoseconds_per_op;
+};
+
+struct CampusScale {
+    unsigned int resource_count;
+    unsigned int event_count;
+};
+
+static const double MIN_BENCHMARK_SECONDS = 0.2;
+static const unsigned long MAX_BENCHMARK_ITERATIONS = 1UL << 30;
+static const unsigned int QUERY_POOL_SIZE = 1024;
+static const unsigned int CALENDAR_SAMPLE_SIZE = 10000;
+static const int EVENT_SPACING_MINUTES = 60;
+static const int EVENT_DURATION_MINUTES = 50;
+static const CampusScale CAMPUS_SCALES[] = {
+    {10, 10}, {100, 1000}, {1000, 10000}, {10000, 100000}, {100000, 1000000}
+};
+
+static const char BENCH_PAGES_MAGIC[4] = {'C', 'R', 'M', 'B'};
+
+static volatile unsigned long benchmark_sink = 0;
+
+template <typename Operation>
+static BenchmarkResult runBenchmark(const std::string& name, const CampusScale& scale, Operation operation) {
+    unsigned long iterations = 1;
+    
+    while (true) {
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        for (unsigned long i = 0; i < iterations; i++) {
+            benchmark_sink += operation(i);
+        }
+        double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        
+        if (elapsed >= MIN_BENCHMARK_SECONDS || iterations >= MAX_BENCHMARK_ITERATIONS) {
+            BenchmarkResult result = {name, scale.resource_count, scale.event_count, iterations, elapsed * 1e9 / iterations};
+            std::cerr << "  " << name << ": " << result.nanoseconds_per_op << " ns/op over "
+                      << iterations << " iteration(s)" << std::endl;
+            return result;
+        }
+        
+        unsigned long next = (elapsed > 0) ? static_cast<unsigned long>(iterations * MIN_BENCHMARK_SECONDS * 1.4 / elapsed) : 0;
+        if (next <= iterations) {
+            next = iterations * 10;
+        }
+        iterations = (next > iterations * 10) ? iterations * 10 : next;
+    }
+}
+
+static void buildCampus(ResourceManager& resource_manager, EventManager& event_manager,
+                        const CampusScale& scale, long base_stamp) {
+    std::string error;
+    
+    for (unsigned int r = 0; r < scale.resource_count; r++) {
+        resource_manager.createResource("Room " + std::to_string(r + 1), (r % 3 == 0) ? "Lab" : "Classroom", true, error);
+    }
+    
+    std::vector<unsigned int> resource_ids(1);
+    for (unsigned int e = 0; e < scale.event_count; e++) {
+        resource_ids[0] = e % scale.resource_count + 1;
+        long stamp = base_stamp + static_cast<long>(e / scale.resource_count) * EVENT_SPACING_MINUTES;
+        if (event_manager.createEvent("Event " + std::to_string(e + 1), stampToDate(stamp), stampToTime(stamp),
+                                      EVENT_DURATION_MINUTES, resource_ids, error) == 0) {
+            std::cerr << "Error: " << error << std::endl;
+            std::exit(1);
+        }
+    }
+}
+
+static void benchmarkBackends(EventManager& event_manager, const CampusScale& scale, const std::string& suffix,
+                              std::vector<BenchmarkResult>& results) {
+    std::string error;
+    EventCodec codec;
+    TextStore<Event> text_store(event_manager.getStorePath(TEXT_STORAGE), codec);
+    std::vector<Event> stored_events;
+    std::vector<DamagedRecord> damaged;
+    event_manager.saveAs(TEXT_STORAGE, error);
+    text_store.load(stored_events, damaged);
+    if (stored_events.empty()) {
+        return;
+    }
+    
+    std::vector<const Event*> stored_records;
+    for (unsigned int i = 0; i < stored_events.size(); i++) {
+        stored_records.push_back(&stored_events[i]);
+    }
+    
+    PagedStore<Event> paged_store("data/bench.pages", BENCH_PAGES_MAGIC, codec);
+    SqliteStore<Event> sqlite_store("data/bench.db", codec);
+    StorageBackend<Event>* backends[2] = {&paged_store, &sqlite_store};
+    const char* const backend_names[2] = {"PagedStore", "SqliteStore"};
+    
+    for (unsigned int b = 0; b < 2; b++) {
+        StorageBackend<Event>& store = *backends[b];
+        std::string name = backend_names[b];
+        
+        results.push_back(runBenchmark(name + "::rewrite" + suffix, scale, [&](unsigned long) {
+            return store.rewrite(stored_records) ? 1UL : 0UL;
+        }));
+        
+        results.push_back(runBenchmark(name + "::load" + suffix, scale, [&](unsigned long) {
+            std::vector<Event> records;
+            std::vector<DamagedRecord> damaged;
+            store.load(records, damaged);
+            return static_cast<unsigned long>(records.size());
+        }));
+        
+        results.push_back(runBenchmark(name + "::commit" + suffix, scale, [&](unsigned long i) {
+            std::vector<const Event*> puts(1, stored_records[(i * 7919u) % stored_records.size()]);
+            return store.commit(puts, std::vector<unsigned int>()) ? 1UL : 0UL;
+        }));
+    }
+    
+    event_manager.saveAs(PAGED_STORAGE, error);
+    results.push_back(runBenchmark("EventManager::loadFrom(paged)" + suffix, scale, [&](unsigned long) {
+        event_manager.loadFrom(PAGED_STORAGE);
+        return static_cast<unsigned long>(event_manager.getEventCount());
+    }));
+    
+    event_manager.saveAs(SQLITE_STORAGE, error);
+    results.push_back(runBenchmark("EventManager::loadFrom(sqlite)" + suffix, scale, [&](unsigned long) {
+        event_manager.loadFrom(SQLITE_STORAGE);
+        return static_cast<unsigned long>(event_manager.getEventCount());
+    }));
+    event_manager.saveAs(TEXT_STORAGE, error);
+}
+
+static void benchmarkArchive(EventManager& event_manager, const CampusScale& scale, const std::string& suffix,
+                             long base_stamp, std::vector<BenchmarkResult>& results) {
+    unsigned int archived_count;
+    std::string error;
+    if (!event_manager.archiveEvents("2030-01-01", archived_count, error)) {
+        std::cerr << "Error: " << error << std::endl;
+        return;
+    }
+    
+    results.push_back(runBenchmark("EventManager::loadFrom(text)/archived" + suffix, scale, [&](unsigned long) {
+        event_manager.loadFrom(TEXT_STORAGE);
+        return static_cast<unsigned long>(event_manager.getArchivedCount());
+    }));
+    
+    results.push_back(runBenchmark("EventManager::lookupEvent/archived" + suffix, scale, [&](unsigned long i) {
+        Event event;
+        return static_cast<unsigned long>(event_manager.lookupEvent(((i % QUERY_POOL_SIZE) * 7919u) %
+                                                                    scale.event_count + 1, event));
+    }));
+    
+    event_manager.setArchiveCacheCapacity(0);
+    results.push_back(runBenchmark("EventManager::lookupEvent/uncached" + suffix, scale, [&](unsigned long i) {
+        Event event;
+        return static_cast<unsigned long>(event_manager.lookupEvent((i * 7919u) % scale.event_count + 1, event));
+    }));
+    event_manager.setArchiveCacheCapacity(EventArchive::DEFAULT_CACHE_CAPACITY);
+    
+    results.push_back(runBenchmark("EventManager::hasConflict/archived" + suffix, scale, [&](unsigned long i) {
+        std::vector<unsigned int> ids(1, static_cast<unsigned int>((i * 7919u) % scale.resource_count + 1));
+        return static_cast<unsigned long>(event_manager.hasConflict(ids, base_stamp, 5));
+    }));
+}
+
+static void benchmarkScale(const CampusScale& scale, std::vector<BenchmarkResult>& results) {
+    std::filesystem::remove_all("data");
+    std::filesystem::create_directory("data");
+    std::cerr << "Campus with " << scale.resource_count << " resources and " << scale.event_count << " events" << std::endl;
+    
+    ResourceManager resource_manager;
+    EventManager event_manager(&resource_manager);
+    resource_manager.setAutoSave(false);
+    event_manager.setAutoSave(false);
+    std::string error;
+    
+    long base_stamp = toMinuteStamp("2026-01-05", "08:00");
+    buildCampus(resource_manager, event_manager, scale, base_stamp);
+    
+    unsigned int slots_per_resource = (scale.event_count + scale.resource_count - 1) / scale.resource_count;
+    std::string suffix = "/" + std::to_string(scale.event_count);
+    std::vector<std::string> event_titles;
+    std::vector<std::string> resource_names;
+    
+    for (unsigned int i = 0; i < QUERY_POOL_SIZE; i++) {
+        event_titles.push_back("EVENT " + std::to_string((i * 7919u) % scale.event_count + 1));
+        resource_names.push_back("room " + std::to_string((i * 7919u) % scale.resource_count + 1));
+    }
+    
+    results.push_back(runBenchmark("EventManager::hasConflict" + suffix, scale, [&](unsigned long i) {
+        std::vector<unsigned int> ids(1, static_cast<unsigned int>((i * 7919u) % scale.resource_count + 1));
+        long stamp = base_stamp + static_cast<long>((i * 31u) % (slots_per_resource + 1)) * EVENT_SPACING_MINUTES
+                     + static_cast<long>(i % 2) * EVENT_DURATION_MINUTES;
+        return static_cast<unsigned long>(event_manager.hasConflict(ids, stamp, 5));
+    }));
+    
+    results.push_back(runBenchmark("EventManager::isResourceUsedByEvents" + suffix, scale, [&](unsigned long i) {
+        return static_cast<unsigned long>(event_manager.isResourceUsedByEvents((i * 7919u) % (scale.resource_count + 1) + 1));
+    }));
+    
+    results.push_back(runBenchmark("ResourceManager::findResource" + suffix, scale, [&](unsigned long i) {
+        return static_cast<unsigned long>(resource_manager.findResource((i * 7919u) % scale.resource_count + 1) != NULL);
+    }));
+    
+    results.push_back(runBenchmark("EventManager::findEventByTitle" + suffix, scale, [&](unsigned long i) {
+        return static_cast<unsigned long>(event_manager.findEventByTitle(event_titles[i % QUERY_POOL_SIZE]) != NULL);
+    }));
+    
+    results.push_back(runBenchmark("ResourceManager::matchResourcesByName" + suffix, scale, [&](unsigned long i) {
+        return static_cast<unsigned long>(resource_manager.matchResourcesByName(resource_names[i % QUERY_POOL_SIZE]).size());
+    }));
+    
+    std::string week_start = stampToDate(base_stamp);
+    std::string week_end = stampToDate(base_stamp + 6 * 1440);
+    results.push_back(runBenchmark("EventManager::listResourceOccurrences" + suffix, scale, [&](unsigned long i) {
+        std::vector<Event> occurrences;
+        std::string error;
+        event_manager.listResourceOccurrences((i * 7919u) % scale.resource_count + 1, week_start, week_end,
+                                              occurrences, error);
+        return static_cast<unsigned long>(occurrences.size());
+    }));
+    
+    std::vector<Event> calendar_occurrences;
+    std::string calendar_error;
+    event_manager.listOccurrences(week_start, week_start, calendar_occurrences, calendar_error);
+    if (calendar_occurrences.size() > CALENDAR_SAMPLE_SIZE) {
+        calendar_occurrences.resize(CALENDAR_SAMPLE_SIZE);
+    }
+    std::ofstream discard("/dev/null");
+    CalendarView text_calendar(resource_manager, false, 0);
+    results.push_back(runBenchmark("CalendarView::write/text" + suffix, scale, [&](unsigned long) {
+        std::string error;
+        text_calendar.write("Day calendar", calendar_occurrences, 0, discard, error);
+        return static_cast<unsigned long>(calendar_occurrences.size());
+    }));
+    
+    CalendarView json_calendar(resource_manager, true, 0);
+    results.push_back(runBenchmark("CalendarView::write/jsonl" + suffix, scale, [&](unsigned long) {
+        std::string error;
+        json_calendar.write("Day calendar", calendar_occurrences, 0, discard, error);
+        return static_cast<unsigned long>(calendar_occurrences.size());
+    }));
+    
+    results.push_back(runBenchmark("EventManager::buildUtilizationReport" + suffix, scale, [&](unsigned long) {
+        UtilizationReport report;
+        std::string error;
+        event_manager.buildUtilizationReport("2026-01-01", "2026-12-31", "", "", report, error);
+        return static_cast<unsigned long>(report.getBookedMinutes());
+    }));
+    
+    results.push_back(runBenchmark("ResourceManager::saveAs(text)" + suffix, scale, [&](unsigned long) {
+        resource_manager.saveAs(TEXT_STORAGE, error);
+        return 0UL;
+    }));
+    
+    results.push_back(runBenchmark("ResourceManager::loadFrom(text)" + suffix, scale, [&](unsigned long) {
+        resource_manager.loadFrom(TEXT_STORAGE);
+        return static_cast<unsigned long>(resource_manager.getResourceCount());
+    }));
+    
+    resource_manager.saveAs(PAGED_STORAGE, error);
+    results.push_back(runBenchmark("ResourceManager::save(paged)" + suffix, scale, [&](unsigned long i) {
+        std::string error;
+        unsigned int id = (i * 7919u) % scale.resource_count + 1;
+        resource_manager.modifyResource(id, "", (i % 2) ? "Lab" : "Classroom", -1, false, error);
+        resource_manager.save(error);
+        return 0UL;
+    }));
+    resource_manager.saveAs(TEXT_STORAGE, error);
+    
+    std::vector<unsigned int> churn_ids;
+    for (unsigned int i = 0; i < QUERY_POOL_SIZE && i < scale.event_count; i++) {
+        churn_ids.push_back((i * 7919u) % scale.event_count + 1);
+    }
+    results.push_back(runBenchmark("EventManager::removeEvent" + suffix, scale, [&](unsigned long i) {
+        unsigned int& id = churn_ids[i % churn_ids.size()];
+        Event event;
+        std::string error;
+        if (!event_manager.lookupEvent(id, event) || !event_manager.removeEvent(id, error)) {
+            return 0UL;
+        }
+        id = event_manager.createEvent(event.getTitle(), event.getDate(), event.getStartTime(),
+                                       event.getDurationMinutes(), event.getResourceIds().toVector(), error);
+        return static_cast<unsigned long>(id);
+    }));
+    
+    results.push_back(runBenchmark("EventManager::saveAs(text)" + suffix, scale, [&](unsigned long) {
+        event_manager.saveAs(TEXT_STORAGE, error);
+        return 0UL;
+    }));
+    
+    results.push_back(runBenchmark("EventManager::loadFrom(text)" + suffix, scale, [&](unsigned long) {
+        event_manager.loadFrom(TEXT_STORAGE);
+        return static_cast<unsigned long>(event_manager.getEventCount());
+    }));
+    
+    benchmarkBackends(event_manager, scale, suffix, results);
+    benchmarkArchive(event_manager, scale, suffix, base_stamp, results);
+}
+
+static void writeJson(const std::vector<BenchmarkResult>& results, std::ostream& output) {
+    output << "{\n";
+    output << "  \"context\": {\n";
+    output << "    \"executable\": \"campus_bench\",\n";
+    output << "    \"min_time_seconds\": " << MIN_BENCHMARK_SECONDS << "\n";
+    output << "  },\n";
+    output << "  \"benchmarks\": [\n";
+    
+    for (unsigned int i = 0; i < results.size(); i++) {
+        output << "    {\"name\": \"" << results[i].name << "\", "
+               << "\"resources\": " << results[i].resource_count << ", "
+               << "\"events\": " << results[i].event_count << ", "
+               << "\"iterations\": " << results[i].iterations << ", "
+               << "\"real_time\": " << results[i].nanoseconds_per_op << ", "
+               << "\"time_unit\": \"ns\"}" << (i + 1 < results.size() ? "," : "") << "\n";
+    }
+    
+    output << "  ]\n";
+    output << "}" << std::endl;
+}
+
+int main(int argc, char** argv) {
+    std::string data_dir = "bench_data";
+    unsigned int max_events = 1000000;
+    
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "--data-dir" && i + 1 < argc) {
+            data_dir = argv[++i];
+        } else if (arg == "--max-events" && i + 1 < argc && parseUnsigned(argv[i + 1], max_events)) {
+            i++;
+        } else {
+            std::cerr << "Usage: " << argv[0] << " [--data-dir DIR] [--max-events N]" << std::endl;
+            return 1;
+        }
+    }
+    
+    std::error_code error;
+    if (std::filesystem::exists(data_dir, error) && !std::filesystem::is_empty(data_dir, error)) {
+        std::cerr << "Error: Benchmark directory '" << data_dir << "' is not empty; give a new or empty directory"
+                  << std::endl;
+        return 1;
+    }
+    bool created_dir = std::filesystem::create_directories(data_dir, error);
+    std::filesystem::path previous_dir = std::filesystem::current_path();
+    std::filesystem::current_path(data_dir, error);
+    if (error) {
+        std::cerr << "Error: Cannot use benchmark directory '" << data_dir << "'" << std::endl;
+        return 1;
+    }
+    
+    std::vector<BenchmarkResult> results;
+    for (unsigned int i = 0; i < sizeof(CAMPUS_SCALES) / sizeof(CAMPUS_SCALES[0]); i++) {
+        if (CAMPUS_SCALES[i].event_count <= max_events) {
+            benchmarkScale(CAMPUS_SCALES[i], results);
+        }
+    }
+    
+    std::filesystem::remove_all("data");
+    std::filesystem::current_path(previous_dir);
+    if (created_dir) {
+        std::filesystem::remove(data_dir, error);
+    }
+    writeJson(results, std::cout);
+    return 0;
+}
@@ -0,0 +1,289 @@
+#include "ResourceManager.hpp"
+#include "EventManager.hpp"
+#include "DurableFile.hpp"
+#include "outils.hpp"
+#include <filesystem>
+#include <iostream>
+#include <map>
+#include <string>
+#include <vector>
+#include <sys/wait.h>
+#include <unistd.h>
+
+static const unsigned int BOOKABLE_RESOURCES = 4;
+static const unsigned int LARGE_RECORD_BYTES = 4500;
+static const char* const FORMAT_NAMES[] = {"text", "binary", "paged"};
+
+struct CrashOptions {
+    std::string directory;
+    unsigned int trials;
+    unsigned int operations;
+    unsigned int seed;
+};
+
+struct TrialState {
+    std::map<unsigned int, std::string> resources;
+    std::map<unsigned int, std::string> events;
+    char pending_kind;
+    unsigned int pending_id;
+    unsigned int highest_id;
+};
+
+static unsigned int nextRandom(unsigned int& state) {
+    state = state * 1103515245u + 12345u;
+    return state >> 8;
+}
+
+static void report(int fd, char tag, char kind, unsigned int id, const std::string& record) {
+    std::string line = std::string(1, tag) + '\t' + kind + '\t' + std::to_string(id) + '\t' + record + '\n';
+    std::size_t written = 0;
+    while (written < line.size()) {
+        ssize_t result = write(fd, line.data() + written, line.size() - written);
+        if (result <= 0) {
+            return;
+        }
+        written += result;
+    }
+}
+
+static void saveAll(ResourceManager& resource_manager, EventManager& event_manager, unsigned int format) {
+    std::string error;
+    resource_manager.saveAs(static_cast<StorageFormat>(format), error);
+    event_manager.saveAs(static_cast<StorageFormat>(format), error);
+}
+
+static void runWriter(int fd, unsigned int format, unsigned int operations, unsigned int crash_after,
+                      unsigned int seed) {
+    ResourceManager resource_manager;
+    EventManager event_manager(&resource_manager);
+    std::string error;
+    Resource resource;
+    Event event;
+
+    for (unsigned int i = 0; i < BOOKABLE_RESOURCES; i++) {
+        unsigned int id = resource_manager.createResource("Hall " + std::to_string(i + 1), "Hall", true, error);
+        resource_manager.lookupResource(id, resource);
+        report(fd, 'A', 'R', id, resource.toString());
+    }
+    saveAll(resource_manager, event_manager, format);
+    armFaultInjection(crash_after);
+
+    std::vector<unsigned int> rooms;
+    std::vector<unsigned int> bookings;
+    long base_stamp = toMinuteStamp("2027-03-01", "08:00");
+    unsigned int slot = 0;
+
+    for (unsigned int i = 0; i < operations; i++) {
+        unsigned int roll = nextRandom(seed) % 100;
+        if (roll < 25 || (roll < 50 && rooms.empty())) {
+            report(fd, 'B', 'R', 0, "");
+            unsigned int id = resource_manager.createResource("Room " + std::to_string(i), "Lab", true, error);
+            resource_manager.lookupResource(id, resource);
+            rooms.push_back(id);
+            report(fd, 'A', 'R', id, resource.toString());
+        } else if (roll < 40) {
+            unsigned int id = rooms[nextRandom(seed) % rooms.size()];
+            std::string type = (nextRandom(seed) % 8 == 0) ? std::string(LARGE_RECORD_BYTES, 'x') : "Type " + std::to_string(i);
+            report(fd, 'B', 'R', id, "");
+            resource_manager.modifyResource(id, "", type, -1, false, error);
+            resource_manager.lookupResource(id, resource);
+            report(fd, 'A', 'R', id, resource.toString());
+        } else if (roll < 50) {
+            unsigned int index = nextRandom(seed) % rooms.size();
+            unsigned int id = rooms[index];
+            rooms.erase(rooms.begin() + index);
+            report(fd, 'B', 'R', id, "");
+            resource_manager.removeResource(id, error);
+            report(fd, 'A', 'R', id, "");
+        } else if (roll < 80 || (roll < 90 && bookings.empty())) {
+            long stamp = base_stamp + static_cast<long>(slot++) * 60;
+            std::vector<unsigned int> resource_ids(1, slot % BOOKABLE_RESOURCES + 1);
+            report(fd, 'B', 'E', 0, "");
+            unsigned int id = event_manager.createEvent("Session " + std::to_string(i), stampToDate(stamp),
+                                                        stampToTime(stamp), 50, resource_ids, error);
+            event_manager.lookupEvent(id, event);
+            bookings.push_back(id);
+            report(fd, 'A', 'E', id, event.toString());
+        } else if (roll < 90) {
+            unsigned int index = nextRandom(seed) % bookings.size();
+            unsigned int id = bookings[index];
+            bookings.erase(bookings.begin() + index);
+            report(fd, 'B', 'E', id, "");
+            event_manager.removeEvent(id, error);
+            report(fd, 'A', 'E', id, "");
+        } else {
+            saveAll(resource_manager, event_manager, format);
+        }
+    }
+}
+
+static void applyReport(const std::string& line, TrialState& state) {
+    std::string_view fields[4];
+    unsigned int field_count = splitFields(line, '\t', fields, 4);
+    if (field_count < 3 || field_count > 4) {
+        return;
+    }
+
+    unsigned int id = 0;
+    parseUnsigned(fields[2], id);
+    state.highest_id = (id > state.highest_id) ? id : state.highest_id;
+    if (fields[0] == "B") {
+        state.pending_kind = fields[1][0];
+        state.pending_id = id;
+        return;
+    }
+
+    std::map<unsigned int, std::string>& records = (fields[1] == "R") ? state.resources : state.events;
+    if (fields[3].empty()) {
+        records.erase(id);
+    } else {
+        records[id] = std::string(fields[3]);
+    }
+    state.pending_kind = 0;
+}
+
+static unsigned int countMismatches(const std::map<unsigned int, std::string>& expected, char kind,
+                                    const TrialState& state, ResourceManager& resource_manager,
+                                    EventManager& event_manager) {
+    unsigned int mismatches = 0;
+    bool pending = (state.pending_kind == kind);
+
+    for (unsigned int id = 1; id <= state.highest_id + 2; id++) {
+        std::string loaded;
+        Resource resource;
+        Event event;
+        if (kind == 'R' && resource_manager.lookupResource(id, resource)) {
+            loaded = resource.toString();
+        } else if (kind == 'E' && event_manager.lookupEvent(id, event)) {
+            loaded = event.toString();
+        }
+
+        std::map<unsigned int, std::string>::const_iterator it = expected.find(id);
+        std::string wanted = (it != expected.end()) ? it->second : "";
+        if (loaded == wanted) {
+            continue;
+        }
+        if (pending && (state.pending_id == id || (state.pending_id == 0 && wanted.empty()))) {
+            pending = false;
+            continue;
+        }
+        mismatches++;
+    }
+    return mismatches;
+}
+
+static bool runTrial(unsigned int trial, const CrashOptions& options, unsigned int& seed,
+                     bool& crashed, unsigned int& quarantined) {
+    std::filesystem::remove_all("data");
+    std::filesystem::create_directory("data");
+    unsigned int format = trial % 3;
+    unsigned int crash_after = nextRandom(seed) % (options.operations + options.operations / 4) + 1;
+    unsigned int writer_seed = nextRandom(seed);
+
+    int channel[2];
+    if (pipe(channel) != 0) {
+        return false;
+    }
+    pid_t pid = fork();
+    if (pid < 0) {
+        return false;
+    }
+    if (pid == 0) {
+        close(channel[0]);
+        runWriter(channel[1], format, options.operations, crash_after, writer_seed);
+        std::_Exit(0);
+    }
+
+    close(channel[1]);
+    std::string output;
+    char buffer[4096];
+    ssize_t received;
+    while ((received = read(channel[0], buffer, sizeof(buffer))) > 0) {
+        output.append(buffer, received);
+    }
+    close(channel[0]);
+    int status = 0;
+    waitpid(pid, &status, 0);
+    crashed = WIFEXITED(status) && WEXITSTATUS(status) == FAULT_EXIT_CODE;
+
+    TrialState state;
+    state.pending_kind = 0;
+    state.pending_id = 0;
+    state.highest_id = 0;
+    std::string::size_type line_start = 0;
+    std::string::size_type line_end;
+    while ((line_end = output.find('\n', line_start)) != std::string::npos) {
+        applyReport(output.substr(line_start, line_end - line_start), state);
+        line_start = line_end + 1;
+    }
+
+    ResourceManager resource_manager;
+    EventManager event_manager(&resource_manager);
+    resource_manager.load();
+    event_manager.load();
+    quarantined = resource_manager.getDamagedRecordCount() + event_manager.getDamagedRecordCount();
+
+    unsigned int mismatches = countMismatches(state.resources, 'R', state, resource_manager, event_manager) +
+                              countMismatches(state.events, 'E', state, resource_manager, event_manager);
+    if (mismatches > 0) {
+        std::cerr << "Error: trial " << trial << " (" << FORMAT_NAMES[format] << ", crash after "
+                  << crash_after << " writes) lost or corrupted " << mismatches << " record(s)" << std::endl;
+        return false;
+    }
+    return true;
+}
+
+int main(int argc, char** argv) {
+    CrashOptions options = {"crashtest_run", 300, 200, 1};
+
+    for (int i = 1; i + 1 < argc; i += 2) {
+        std::string arg = argv[i];
+        bool valid = true;
+        if (arg == "--dir") {
+            options.directory = argv[i + 1];
+        } else if (arg == "--trials") {
+            valid = parseUnsigned(argv[i + 1], options.trials);
+        } else if (arg == "--operations") {
+            valid = parseUnsigned(argv[i + 1], options.operations) && options.operations > 0;
+        } else if (arg == "--seed") {
+            valid = parseUnsigned(argv[i + 1], options.seed);
+        } else {
+            valid = false;
+        }
+        if (!valid) {
+            std::cerr << "Error: Invalid option '" << arg << "'" << std::endl;
+            return 1;
+        }
+    }
+    if (argc % 2 == 0) {
+        std::cerr << "Usage: " << argv[0] << " [--dir PATH] [--trials N] [--operations N] [--seed N]" << std::endl;
+        return 1;
+    }
+
+    std::error_code error;
+    std::filesystem::create_directories(options.directory, error);
+    if (error || chdir(options.directory.c_str()) != 0) {
+        std::cerr << "Error: Cannot use directory " << options.directory << std::endl;
+        return 1;
+    }
+
+    unsigned int seed = options.seed;
+    unsigned int crashes = 0;
+    unsigned int quarantined_total = 0;
+    unsigned int failures = 0;
+    for (unsigned int trial = 0; trial < options.trials; trial++) {
+        bool crashed = false;
+        unsigned int quarantined = 0;
+        if (!runTrial(trial, options, seed, crashed, quarantined)) {
+            failures++;
+        }
+        crashes += crashed ? 1 : 0;
+        quarantined_total += quarantined;
+    }
+
+    std::cout << "{\"trials\": " << options.trials
+              << ", \"crashed\": " << crashes
+              << ", \"quarantined_records\": " << quarantined_total
+              << ", \"failed\": " << failures << "}" << std::endl;
+    return failures > 0 ? 1 : 0;
+}
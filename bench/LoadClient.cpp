@@ -0,0 +1,250 @@
+#include "outils.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+struct LoadOptions {
+    std::string socket_path;
+    unsigned int connections;
+    unsigned int requests_per_connection;
+    unsigned int resource_count;
+    unsigned int write_percent;
+};
+
+class LineConnection {
+    private:
+        int fd;
+        std::string buffer;
+
+        LineConnection(const LineConnection& other);
+        LineConnection& operator=(const LineConnection& other);
+
+    public:
+        LineConnection();
+        ~LineConnection();
+
+        bool open(const std::string& path);
+        bool sendLine(const std::string& line);
+        bool readLine(std::string& line);
+        bool call(const std::string& request, bool has_records, std::string& status);
+};
+
+LineConnection::LineConnection() {
+    fd = -1;
+}
+
+LineConnection::~LineConnection() {
+    if (fd >= 0) {
+        close(fd);
+    }
+}
+
+bool LineConnection::open(const std::string& path) {
+    sockaddr_un address;
+    std::memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    if (path.length() >= sizeof(address.sun_path)) {
+        return false;
+    }
+    std::memcpy(address.sun_path, path.c_str(), path.length());
+    
+    fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    return fd >= 0 && connect(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) == 0;
+}
+
+bool LineConnection::sendLine(const std::string& line) {
+    std::string request = line + '\n';
+    std::string::size_type sent_total = 0;
+    while (sent_total < request.length()) {
+        ssize_t sent = send(fd, request.data() + sent_total, request.length() - sent_total, MSG_NOSIGNAL);
+        if (sent <= 0) {
+            return false;
+        }
+        sent_total += sent;
+    }
+    return true;
+}
+
+bool LineConnection::readLine(std::string& line) {
+    std::string::size_type newline;
+    while ((newline = buffer.find('\n')) == std::string::npos) {
+        char chunk[4096];
+        ssize_t received = recv(fd, chunk, sizeof(chunk), 0);
+        if (received <= 0) {
+            return false;
+        }
+        buffer.append(chunk, received);
+    }
+    line = buffer.substr(0, newline);
+    buffer.erase(0, newline + 1);
+    return true;
+}
+
+bool LineConnection::call(const std::string& request, bool has_records, std::string& status) {
+    if (!sendLine(request) || !readLine(status)) {
+        return false;
+    }
+    
+    unsigned int record_count = 0;
+    if (has_records && status.compare(0, 3, "OK ") == 0) {
+        parseUnsigned(std::string_view(status).substr(3), record_count);
+    }
+    
+    std::string record;
+    for (unsigned int i = 0; i < record_count; i++) {
+        if (!readLine(record)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static unsigned int nextRandom(unsigned int& state) {
+    state = state * 1103515245u + 12345u;
+    return state >> 8;
+}
+
+static bool setupResources(const LoadOptions& options, unsigned int& first_resource_id) {
+    LineConnection connection;
+    if (!connection.open(options.socket_path)) {
+        return false;
+    }
+    
+    std::string status;
+    for (unsigned int i = 0; i < options.resource_count; i++) {
+        if (!connection.call("add-resource|Load Room " + std::to_string(i + 1) + "|Classroom|1", false, status) ||
+            status.compare(0, 3, "OK ") != 0) {
+            return false;
+        }
+        unsigned int id = 0;
+        parseUnsigned(std::string_view(status).substr(3), id);
+        if (i == 0) {
+            first_resource_id = id;
+        }
+    }
+    return true;
+}
+
+static void runClient(const LoadOptions& options, unsigned int client_index, unsigned int first_resource_id,
+                      long base_stamp, std::vector<double>& latencies, std::atomic<unsigned int>& failures) {
+    LineConnection connection;
+    if (!connection.open(options.socket_path)) {
+        failures += options.requests_per_connection;
+        return;
+    }
+    
+    unsigned int state = client_index * 7919u + 17u;
+    std::string status;
+    latencies.reserve(options.requests_per_connection);
+    
+    for (unsigned int i = 0; i < options.requests_per_connection; i++) {
+        unsigned int resource_id = first_resource_id + nextRandom(state) % options.resource_count;
+        long stamp = base_stamp + static_cast<long>(nextRandom(state) % 20000) * 30;
+        unsigned int kind = nextRandom(state) % 100;
+        std::string request;
+        bool has_records = true;
+        
+        if (kind < options.write_percent) {
+            request = "add-event|Load " + std::to_string(client_index) + "-" + std::to_string(i) + "|" +
+                      stampToDate(stamp) + "|" + stampToTime(stamp) + "|60|" + std::to_string(resource_id);
+            has_records = false;
+        } else if (kind < options.write_percent + (100 - options.write_percent) / 2) {
+            request = "free-slots|" + std::to_string(resource_id) + "|90|" + stampToDate(stamp) + "|" +
+                      stampToDate(stamp + 7 * 1440) + "|08:00|18:00|3";
+        } else {
+            request = "get-event|" + std::to_string(nextRandom(state) % 1000 + 1);
+        }
+        
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        if (!connection.call(request, has_records, status)) {
+            failures += options.requests_per_connection - i;
+            return;
+        }
+        latencies.push_back(std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count());
+    }
+}
+
+static double percentile(const std::vector<double>& sorted, double fraction) {
+    if (sorted.empty()) {
+        return 0;
+    }
+    std::vector<double>::size_type index = static_cast<std::vector<double>::size_type>(fraction * (sorted.size() - 1));
+    return sorted[index];
+}
+
+int main(int argc, char** argv) {
+    LoadOptions options = {"campus.sock", 16, 2000, 50, 20};
+    
+    for (int i = 1; i + 1 < argc; i += 2) {
+        std::string arg = argv[i];
+        bool valid = true;
+        if (arg == "--socket") {
+            options.socket_path = argv[i + 1];
+        } else if (arg == "--connections") {
+            valid = parseUnsigned(argv[i + 1], options.connections) && options.connections > 0;
+        } else if (arg == "--requests") {
+            valid = parseUnsigned(argv[i + 1], options.requests_per_connection);
+        } else if (arg == "--resources") {
+            valid = parseUnsigned(argv[i + 1], options.resource_count) && options.resource_count > 0;
+        } else if (arg == "--write-percent") {
+            valid = parseUnsigned(argv[i + 1], options.write_percent) && options.write_percent <= 100;
+        } else {
+            valid = false;
+        }
+        if (!valid) {
+            std::cerr << "Error: Invalid option '" << arg << "'" << std::endl;
+            return 1;
+        }
+    }
+    if (argc % 2 == 0) {
+        std::cerr << "Usage: " << argv[0] << " [--socket PATH] [--connections N] [--requests N]"
+                  << " [--resources N] [--write-percent P]" << std::endl;
+        return 1;
+    }
+    
+    unsigned int first_resource_id = 0;
+    if (!setupResources(options, first_resource_id)) {
+        std::cerr << "Error: Cannot create resources through " << options.socket_path << std::endl;
+        return 1;
+    }
+    
+    std::vector<std::vector<double> > latencies(options.connections);
+    std::vector<std::thread> clients;
+    std::atomic<unsigned int> failures(0);
+    long base_stamp = toMinuteStamp("2027-01-04", "00:00");
+    
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    for (unsigned int i = 0; i < options.connections; i++) {
+        clients.push_back(std::thread(runClient, std::cref(options), i, first_resource_id, base_stamp,
+                                      std::ref(latencies[i]), std::ref(failures)));
+    }
+    for (unsigned int i = 0; i < clients.size(); i++) {
+        clients[i].join();
+    }
+    double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    
+    std::vector<double> all_latencies;
+    for (unsigned int i = 0; i < latencies.size(); i++) {
+        all_latencies.insert(all_latencies.end(), latencies[i].begin(), latencies[i].end());
+    }
+    std::sort(all_latencies.begin(), all_latencies.end());
+    
+    std::cout << "{\"connections\": " << options.connections
+              << ", \"requests\": " << all_latencies.size()
+              << ", \"failed\": " << failures.load()
+              << ", \"seconds\": " << elapsed
+              << ", \"requests_per_second\": " << (elapsed > 0 ? all_latencies.size() / elapsed : 0)
+              << ", \"p50_us\": " << percentile(all_latencies, 0.50)
+              << ", \"p99_us\": " << percentile(all_latencies, 0.99)
+              << ", \"max_us\": " << (all_latencies.empty() ? 0 : all_latencies.back())
+              << "}" << std::endl;
+    return failures.load() == 0 ? 0 : 1;
+}
@@ -0,0 +1,411 @@
+#include "TrigramIndex.hpp"
+#include "Recurrence.hpp"
+#include "PagedFile.hpp"
+#include "Journal.hpp"
+#include "DurableFile.hpp"
+#include "SqliteStore.hpp"
+#include "EventCodec.hpp"
+#include "ResourceManager.hpp"
+#include "EventManager.hpp"
+#include "outils.hpp"
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <filesystem>
+#include <string>
+#include <vector>
+#include <utility>
+#include <cstdlib>
+#include <sys/wait.h>
+#include <unistd.h>
+
+struct CheckTally {
+    unsigned int checks;
+    unsigned int failed;
+};
+
+static void expect(CheckTally& tally, bool passed, const std::string& description) {
+    tally.checks++;
+    if (!passed) {
+        tally.failed++;
+        std::cerr << "FAILED: " << description << std::endl;
+    }
+}
+
+static bool fuzzyFinds(const std::string& title, const std::string& term, int expected_distance) {
+    TrigramIndex index;
+    index.add(1, title);
+    std::vector<unsigned int> candidates;
+    int max_distance = index.findSimilarCandidates(term, candidates);
+
+    FuzzyRanker ranker(term, max_distance, 5);
+    for (unsigned int i = 0; i < candidates.size(); i++) {
+        ranker.consider(candidates[i], title);
+    }
+    std::vector<FuzzyMatch> matches = ranker.finish();
+    return matches.size() == 1 && matches[0].id == 1 && matches[0].distance == expected_distance;
+}
+
+static void checkFuzzyTranspositions(CheckTally& tally) {
+    expect(tally, fuzzyFinds("lecture", "lecutre", 1), "'lecutre' finds 'lecture' within one transposition");
+    expect(tally, fuzzyFinds("lecture", "letcure", 1), "'letcure' finds 'lecture' within one transposition");
+    expect(tally, fuzzyFinds("physics seminar", "pyhsics semniar", 2),
+           "'pyhsics semniar' finds 'physics seminar' within two transpositions");
+    expect(tally, fuzzyFinds("lecture", "lectrue", 1), "'lectrue' finds 'lecture' within one transposition");
+}
+
+static std::string listOccurrences(const std::string& rule, const std::string& first_date, unsigned int limit) {
+    Recurrence recurrence;
+    std::string error;
+    if (!recurrence.parse(rule, error) || !recurrence.anchor(stampToDay(toMinuteStamp(first_date, "00:00")), error)) {
+        return "error: " + error;
+    }
+
+    std::string dates;
+    long day = recurrence.nextOn(0);
+    for (unsigned int i = 0; i < limit && day != Recurrence::NO_END; i++) {
+        dates += (dates.empty() ? "" : ",") + stampToDate(day * 1440);
+        day = recurrence.nextOn(day + 1);
+    }
+    return dates;
+}
+
+static void checkWeeklyIntervals(CheckTally& tally) {
+    expect(tally, listOccurrences("FREQ=WEEKLY;INTERVAL=2;BYDAY=MO,WE", "2026-10-21", 4) ==
+                  "2026-10-21,2026-11-02,2026-11-04,2026-11-16",
+           "every other week on Monday and Wednesday counts weeks from the Monday before a Wednesday start");
+    expect(tally, listOccurrences("FREQ=WEEKLY;INTERVAL=2;BYDAY=MO,WE;COUNT=3", "2026-10-21", 10) ==
+                  "2026-10-21,2026-11-02,2026-11-04",
+           "COUNT on a mid-week start ends on the third occurrence");
+    expect(tally, listOccurrences("FREQ=WEEKLY;INTERVAL=3;BYDAY=TU,FR,SU", "2026-10-23", 5) ==
+                  "2026-10-23,2026-10-25,2026-11-10,2026-11-13,2026-11-15",
+           "every third week on Tuesday, Friday and Sunday starting on a Friday");
+    expect(tally, listOccurrences("FREQ=WEEKLY;INTERVAL=2;BYDAY=MO,WE", "2026-10-19", 3) ==
+                  "2026-10-19,2026-10-21,2026-11-02",
+           "every other week starting on a Monday is unchanged");
+}
+
+static std::string scratchPath(const std::string& name) {
+    return (std::filesystem::temp_directory_path() / ("campus_check_" + name)).string();
+}
+
+static void checkPagedReadFailure(CheckTally& tally) {
+    static const char MAGIC[4] = {'C', 'H', 'K', 'P'};
+    std::string path = scratchPath("read_failure.pages");
+    std::vector<std::pair<unsigned int, std::string> > records;
+    for (unsigned int id = 1; id <= 3; id++) {
+        records.push_back(std::make_pair(id, "record " + std::to_string(id)));
+    }
+
+    PagedFile store(path, MAGIC);
+    expect(tally, store.rewrite(records), "a paged store is written");
+    std::filesystem::resize_file(path, PagedFile::PAGE_SIZE + 64);
+
+    std::vector<std::pair<unsigned int, std::string> > puts(1, std::make_pair(2u, std::string("changed")));
+    expect(tally, !store.commit(puts, std::vector<unsigned int>()),
+           "a commit fails when a page it must update cannot be read");
+    expect(tally, std::filesystem::file_size(path) == PagedFile::PAGE_SIZE + 64,
+           "a failed page read leaves the store file as it was");
+    expect(tally, !store.isAttached(), "a failed page read detaches the store so the next save rewrites it");
+    std::filesystem::remove(path);
+}
+
+static std::string readWholeFile(const std::string& path) {
+    std::ifstream file(path, std::ios::in | std::ios::binary);
+    std::stringstream buffer;
+    buffer << file.rdbuf();
+    return buffer.str();
+}
+
+static void checkJournalReplay(CheckTally& tally) {
+    std::string path = scratchPath("replay.log");
+    std::filesystem::remove(path);
+    {
+        Journal journal(path);
+        std::vector<std::string> batch;
+        batch.push_back("2|second");
+        batch.push_back("3|third");
+        expect(tally, journal.append(Journal::PUT, "1|first") && journal.append(Journal::PUT, batch) &&
+                      journal.append(Journal::REMOVE, "1"),
+               "journal entries and a batch are appended");
+    }
+    std::uintmax_t complete_size = std::filesystem::file_size(path);
+    {
+        std::ofstream torn(path, std::ios::out | std::ios::app | std::ios::binary);
+        torn << "P|4|cut off before the newl";
+    }
+
+    Journal replay(path);
+    std::vector<std::string> damaged;
+    std::vector<std::string> entries = replay.readEntries(damaged);
+    expect(tally, entries.size() == 4 && entries[0] == "P|1|first" && entries[1] == "P|2|second" &&
+                  entries[2] == "P|3|third" && entries[3] == "D|1" && damaged.empty(),
+           "journal replay returns every complete entry in order");
+    expect(tally, std::filesystem::file_size(path) == complete_size && replay.getEntryCount() == 4,
+           "journal replay cuts a torn tail off and counts only complete entries");
+
+    std::string content = readWholeFile(path);
+    content.replace(content.find("second"), 6, "SECOND");
+    {
+        std::ofstream corrupted(path, std::ios::out | std::ios::trunc | std::ios::binary);
+        corrupted << content;
+    }
+    entries = replay.readEntries(damaged);
+    expect(tally, entries.size() == 3 && damaged.size() == 1 && damaged[0].find("SECOND") != std::string::npos,
+           "journal replay sets aside an entry whose checksum does not match");
+    std::filesystem::remove(path);
+}
+
+static void checkPagedDoubleWrite(CheckTally& tally) {
+    static const char MAGIC[4] = {'C', 'H', 'K', 'D'};
+    std::string path = scratchPath("double_write.pages");
+    std::vector<std::pair<unsigned int, std::string> > records;
+    for (unsigned int id = 1; id <= 40; id++) {
+        records.push_back(std::make_pair(id, "record " + std::to_string(id) + " " + std::string(300, 'x')));
+    }
+    std::vector<std::pair<unsigned int, std::string> > puts;
+    puts.push_back(std::make_pair(1u, "changed 1 " + std::string(300, 'y')));
+    puts.push_back(std::make_pair(40u, "changed 40 " + std::string(300, 'y')));
+
+    unsigned int crashes = 0;
+    bool saw_batch = false;
+    bool consistent = true;
+    bool finished = false;
+    for (long writes = 0; writes < 32 && !finished; writes++) {
+        {
+            PagedFile store(path, MAGIC);
+            store.rewrite(records);
+        }
+
+        pid_t pid = fork();
+        if (pid == 0) {
+            PagedFile store(path, MAGIC);
+            std::vector<std::string_view> loaded;
+            std::vector<std::string> damaged;
+            bool opened = store.open(loaded, damaged);
+            armFaultInjection(writes);
+            bool committed = opened && store.commit(puts, std::vector<unsigned int>());
+            std::_Exit(committed ? 0 : 1);
+        }
+        int status = 0;
+        if (pid < 0 || waitpid(pid, &status, 0) != pid || !WIFEXITED(status)) {
+            consistent = false;
+            break;
+        }
+        finished = WEXITSTATUS(status) != FAULT_EXIT_CODE;
+        crashes += finished ? 0 : 1;
+        saw_batch = saw_batch || std::filesystem::exists(path + ".dw");
+
+        PagedFile store(path, MAGIC);
+        std::vector<std::string_view> loaded;
+        std::vector<std::string> damaged;
+        unsigned int changed = 0;
+        bool opened = store.recover() && store.open(loaded, damaged);
+        for (unsigned int i = 0; i < loaded.size(); i++) {
+            changed += loaded[i].substr(0, 8) == "changed " ? 1 : 0;
+        }
+        if (!opened || !damaged.empty() || loaded.size() != records.size() || (changed != 0 && changed != puts.size()) ||
+            (finished && changed != puts.size()) || std::filesystem::exists(path + ".dw")) {
+            consistent = false;
+        }
+    }
+
+    expect(tally, finished && crashes > 0 && saw_batch, "paged commits are cut off at every write, some after the .dw batch");
+    expect(tally, consistent, "recovery from the .dw batch leaves either every change of a commit or none");
+    std::filesystem::remove(path);
+    std::filesystem::remove(path + ".dw");
+}
+
+static bool parseEvents(const EventCodec& codec, const char* const* lines, unsigned int count, std::vector<Event>& events) {
+    events.assign(count, Event());
+    for (unsigned int i = 0; i < count; i++) {
+        if (!codec.parseLine(lines[i], events[i])) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static void checkSqliteRewriteAndCommit(CheckTally& tally) {
+    static const char* const ORIGINAL[] = {
+        "1|Lecture|2026-10-19|09:00|90|1,2",
+        "2|Seminar|2026-10-20|14:00|60|3|FREQ=WEEKLY;BYDAY=TU;COUNT=3",
+        "3|Exam|2026-12-01|08:00|180|1,3"
+    };
+    static const char* const CHANGED[] = {
+        "2|Seminar moved|2026-10-21|15:00|45|2,3|FREQ=WEEKLY;BYDAY=WE;COUNT=2",
+        "4|Workshop|2026-11-05|10:00|120|4"
+    };
+    std::string path = scratchPath("events.db");
+    std::filesystem::remove(path);
+
+    EventCodec codec;
+    std::vector<Event> original;
+    std::vector<Event> changed;
+    expect(tally, parseEvents(codec, ORIGINAL, 3, original) && parseEvents(codec, CHANGED, 2, changed),
+           "SQLite check events parse");
+
+    SqliteStore<Event> store(path, codec);
+    std::vector<const Event*> pointers;
+    for (unsigned int i = 0; i < original.size(); i++) {
+        pointers.push_back(&original[i]);
+    }
+    std::vector<Event> loaded;
+    std::vector<DamagedRecord> damaged;
+    bool round_trip = store.rewrite(pointers) && store.load(loaded, damaged) && damaged.empty() &&
+                      loaded.size() == original.size();
+    for (unsigned int i = 0; round_trip && i < loaded.size(); i++) {
+        round_trip = codec.toLine(loaded[i]) == ORIGINAL[i];
+    }
+    expect(tally, round_trip, "a SQLite rewrite reads back every event, its resources and its recurrence");
+
+    pointers.clear();
+    for (unsigned int i = 0; i < changed.size(); i++) {
+        pointers.push_back(&changed[i]);
+    }
+    bool committed = store.canCommitChanges() && store.commit(pointers, std::vector<unsigned int>(1, 1u)) &&
+                     store.load(loaded, damaged) && damaged.empty() && loaded.size() == 3;
+    expect(tally, committed && codec.toLine(loaded[0]) == CHANGED[0] && codec.toLine(loaded[1]) == ORIGINAL[2] &&
+                  codec.toLine(loaded[2]) == CHANGED[1],
+           "a SQLite commit replaces, adds and removes only the given events");
+    std::filesystem::remove(path);
+}
+
+static void writeTextFile(const std::string& path, const std::string& content) {
+    std::ofstream file(path, std::ios::out | std::ios::trunc | std::ios::binary);
+    file << content;
+}
+
+static void checkCsvRejections(CheckTally& tally) {
+    writeTextFile("resources.csv", "name,type,available\n"
+                                   "Room 101,Classroom,yes\n"
+                                   "Room 102,Classroom,maybe\n"
+                                   "\"Lab,Laboratory\n"
+                                   "Projector\n"
+                                   "Desk|4,Furniture\n"
+                                   "Room 103,Classroom\n");
+    ResourceManager resource_manager;
+    resource_manager.load();
+    ImportReport report;
+    std::string error;
+    expect(tally, resource_manager.importFromCsv("resources.csv", report, error) && report.imported == 2 &&
+                  resource_manager.getResourceCount() == 2,
+           "a resource import keeps the valid rows");
+    expect(tally, report.rejected.size() == 4 && report.rejected[0].first == 3 && report.rejected[1].first == 4 &&
+                  report.rejected[2].first == 5 && report.rejected[3].first == 6 &&
+                  report.rejected[0].second == "Invalid availability 'maybe'" &&
+                  report.rejected[1].second == "Unterminated quoted field" &&
+                  report.rejected[2].second == "Expected name,type[,available]" &&
+                  report.rejected[3].second == "Resource name and type cannot be empty or contain '|'",
+           "a resource import reports each rejected line with its reason");
+
+    EventManager event_manager(&resource_manager);
+    event_manager.load();
+    writeTextFile("events.csv", "title,date,start_time,duration,resource_ids\n"
+                                "Lecture,2026-10-19,09:00,90,1\n"
+                                "Overlap,2026-10-19,10:00,30,1\n"
+                                "Nowhere,2026-10-19,09:00,30,9\n"
+                                "Late,2026-02-30,09:00,30,1\n");
+    report = ImportReport();
+    expect(tally, event_manager.importFromCsv("events.csv", report, error) && report.imported == 1 &&
+                  report.rejected.size() == 3 && report.rejected[0].first == 3 && report.rejected[1].first == 4 &&
+                  report.rejected[2].first == 5 && report.rejected[0].second == "Conflicts with line 2" &&
+                  report.rejected[2].second == "Invalid date '2026-02-30'",
+           "an event import reports bad rows and rows that clash with earlier lines");
+}
+
+static void checkConflicts(CheckTally& tally, EventManager& event_manager, unsigned int resource_id) {
+    std::vector<unsigned int> room(1, resource_id);
+    std::string error;
+    expect(tally, event_manager.createEvent("Night lab", "2026-10-20", "23:00", 120, room, error) != 0,
+           "an event may run past midnight");
+    expect(tally, event_manager.createEvent("Early", "2026-10-21", "00:30", 30, room, error) == 0,
+           "an event after midnight conflicts with one that started the day before");
+    expect(tally, event_manager.createEvent("Morning", "2026-10-21", "01:00", 30, room, error) != 0,
+           "an event starting when the overnight one ends does not conflict");
+
+    expect(tally, event_manager.createEvent("Weekly", "2026-11-02", "10:00", 60, room, "FREQ=WEEKLY;COUNT=4", error) != 0,
+           "a weekly event is booked");
+    expect(tally, event_manager.createEvent("Clash", "2026-11-16", "10:30", 30, room, error) == 0,
+           "an event conflicts with a later occurrence of a weekly event");
+    expect(tally, event_manager.createEvent("After", "2026-11-30", "10:00", 60, room, error) != 0,
+           "an event after the last occurrence of a weekly event does not conflict");
+
+    expect(tally, event_manager.createEvent("Night shift", "2026-12-01", "23:30", 60, room,
+                                            "FREQ=WEEKLY;COUNT=2", error) != 0,
+           "a weekly event may run past midnight");
+    expect(tally, event_manager.hasConflict(room, toMinuteStamp("2026-12-09", "00:15"), 15) &&
+                  !event_manager.hasConflict(room, toMinuteStamp("2026-12-16", "00:15"), 15),
+           "only real occurrences of a weekly overnight event conflict after midnight");
+}
+
+static void checkArchiveLookup(CheckTally& tally, EventManager& event_manager, unsigned int resource_id) {
+    std::vector<unsigned int> room(1, resource_id);
+    std::string error;
+    unsigned int first_id = event_manager.createEvent("Old talk", "2025-03-03", "09:00", 60, room, error);
+    unsigned int second_id = event_manager.createEvent("Old course", "2025-04-07", "09:00", 60, room,
+                                                       "FREQ=WEEKLY;COUNT=3", error);
+    unsigned int archived_count = 0;
+    expect(tally, first_id != 0 && second_id != 0 &&
+                  event_manager.archiveEvents("2025-04-01", archived_count, error) && archived_count == 1 &&
+                  event_manager.archiveEvents("2026-01-01", archived_count, error) && archived_count == 1,
+           "two archive runs move one event each");
+
+    Event event;
+    expect(tally, event_manager.lookupEvent(first_id, event) && event.getTitle() == "Old talk" &&
+                  event_manager.lookupEvent(second_id, event) && event.isRecurring(),
+           "archived events from every archive run are found by ID");
+    expect(tally, event_manager.hasConflict(room, toMinuteStamp("2025-04-21", "09:30"), 30) &&
+                  !event_manager.hasConflict(room, toMinuteStamp("2025-04-28", "09:30"), 30),
+           "a conflict check sees occurrences of archived events");
+
+    ResourceManager reloaded_resources;
+    reloaded_resources.load();
+    EventManager reloaded(&reloaded_resources);
+    reloaded.load();
+    expect(tally, reloaded.getArchivedCount() == 2 && reloaded.lookupEvent(first_id, event) &&
+                  reloaded.lookupEvent(second_id, event) && event.getTitle() == "Old course",
+           "archived events are found after a restart");
+}
+
+static void checkManagers(CheckTally& tally) {
+    std::string directory = scratchPath("campus");
+    std::error_code error;
+    std::filesystem::remove_all(directory, error);
+    std::filesystem::create_directories(directory + "/data", error);
+    std::filesystem::path previous_dir = std::filesystem::current_path();
+    std::filesystem::current_path(directory, error);
+    if (error) {
+        expect(tally, false, "the scratch campus directory can be used");
+        return;
+    }
+
+    checkCsvRejections(tally);
+    {
+        ResourceManager resource_manager;
+        resource_manager.load();
+        EventManager event_manager(&resource_manager);
+        event_manager.load();
+        std::string create_error;
+        unsigned int resource_id = resource_manager.createResource("Hall", "Auditorium", true, create_error);
+        checkConflicts(tally, event_manager, resource_id);
+        checkArchiveLookup(tally, event_manager, resource_id);
+    }
+
+    std::filesystem::current_path(previous_dir);
+    std::filesystem::remove_all(directory, error);
+}
+
+int main() {
+    CheckTally tally = {0, 0};
+    checkFuzzyTranspositions(tally);
+    checkWeeklyIntervals(tally);
+    checkPagedReadFailure(tally);
+    checkJournalReplay(tally);
+    checkPagedDoubleWrite(tally);
+    checkSqliteRewriteAndCommit(tally);
+    checkManagers(tally);
+
+    std::cout << "{\"checks\": " << tally.checks << ", \"failed\": " << tally.failed << "}" << std::endl;
+    return tally.failed == 0 ? 0 : 1;
+}
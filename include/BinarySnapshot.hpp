@@ -0,0 +1,61 @@
+#ifndef BINARYSNAPSHOT_HPP
+#define BINARYSNAPSHOT_HPP
+#include <string>
+#include <string_view>
+#include <vector>
+#include <unordered_map>
+#include <cstdint>
+
+const uint32_t SNAPSHOT_VERSION = 1;
+const std::size_t SNAPSHOT_HEADER_SIZE = 24;
+
+struct SnapshotHeader {
+    char magic[4];
+    uint32_t version;
+    uint32_t record_count;
+    uint32_t id_count;
+    uint32_t string_count;
+    uint32_t string_bytes;
+};
+
+class StringTableBuilder {
+    private:
+        std::unordered_map<std::string, uint32_t> lookup;
+        std::vector<uint32_t> offsets;
+        std::string bytes;
+
+    public:
+        StringTableBuilder();
+
+        uint32_t intern(const std::string& str);
+        uint32_t getCount() const;
+        uint32_t getByteSize() const;
+        void appendTo(std::string& out) const;
+};
+
+class StringTableView {
+    private:
+        const char* offsets;
+        const char* bytes;
+        uint32_t count;
+        uint32_t byte_size;
+
+    public:
+        StringTableView();
+
+        bool attach(std::string_view region, uint32_t count, uint32_t byte_size);
+        bool get(uint32_t index, std::string_view& out) const;
+};
+
+void putU32(std::string& out, uint32_t value);
+void putI32(std::string& out, int32_t value);
+void putI64(std::string& out, int64_t value);
+uint32_t readU32(const char* in);
+int32_t readI32(const char* in);
+int64_t readI64(const char* in);
+
+void writeSnapshotHeader(std::string& out, const SnapshotHeader& header);
+bool readSnapshotHeader(std::string_view content, const char* magic, uint32_t max_version, SnapshotHeader& header);
+bool writeFileAtomically(const std::string& path, const std::string& content);
+
+#endif
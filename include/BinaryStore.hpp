@@ -0,0 +1,56 @@
+#ifndef BINARYSTORE_HPP
+#define BINARYSTORE_HPP
+#include "StorageBackend.hpp"
+#include "RecordCodec.hpp"
+#include "MappedFile.hpp"
+#include "BinarySnapshot.hpp"
+#include <string>
+#include <vector>
+#include <filesystem>
+
+template <typename Record>
+class BinaryStore : public StorageBackend<Record> {
+    private:
+        std::string path;
+        const RecordCodec<Record>& codec;
+
+    public:
+        BinaryStore(const std::string& path, const RecordCodec<Record>& codec) : path(path), codec(codec) {
+        }
+
+        bool load(std::vector<Record>& records, std::vector<DamagedRecord>& damaged) override {
+            records.clear();
+            damaged.clear();
+            MappedFile file;
+            return file.open(path) && codec.readSnapshot(file.view(), records);
+        }
+
+        bool rewrite(const std::vector<const Record*>& records) override {
+            std::string content;
+            codec.writeSnapshot(records, content);
+            return writeFileAtomically(path, content);
+        }
+
+        bool commit(const std::vector<const Record*>&, const std::vector<unsigned int>&) override {
+            return false;
+        }
+
+        bool canCommitChanges() const override {
+            return false;
+        }
+
+        bool exists() const override {
+            std::error_code error;
+            return std::filesystem::exists(path, error);
+        }
+
+        StorageFormat getFormat() const override {
+            return BINARY_STORAGE;
+        }
+
+        std::string getPath() const override {
+            return path;
+        }
+};
+
+#endif
@@ -0,0 +1,37 @@
+#ifndef CALENDARVIEW_HPP
+#define CALENDARVIEW_HPP
+#include "Event.hpp"
+#include "ResourceManager.hpp"
+#include <string>
+#include <vector>
+#include <ostream>
+#include <unordered_map>
+
+class CalendarView {
+    public:
+        static constexpr std::size_t FLUSH_BYTES = 64 * 1024;
+        static constexpr unsigned int DEFAULT_PAGE_SIZE = 50;
+
+    private:
+        const ResourceManager& resource_manager;
+        bool json_lines;
+        unsigned int page_size;
+        std::string buffer;
+        std::unordered_map<unsigned int, std::string> resource_names;
+
+        const std::string& resourceName(unsigned int id);
+        void appendNumber(long value);
+        void appendClock(long stamp);
+        void appendText(const Event& occurrence);
+        void appendJson(const Event& occurrence, const std::string& date);
+        void flush(std::ostream& output);
+
+    public:
+        CalendarView(const ResourceManager& resource_manager, bool json_lines, unsigned int page_size);
+
+        unsigned int getPageCount(std::size_t occurrence_count) const;
+        bool write(const std::string& heading, const std::vector<Event>& occurrences, unsigned int page,
+                   std::ostream& output, std::string& error);
+};
+
+#endif
@@ -5,18 +5,49 @@
 #include "EventManager.hpp"
 #include <iostream>
 #include <string>
+#include <string_view>
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
 
 class CampusSystem {
     private:
         ResourceManager resource_manager;
         EventManager event_manager;
         bool is_running;
+        bool is_interactive;
+        std::thread flush_thread;
+        std::mutex flush_mutex;
+        std::condition_variable flush_wakeup;
+        bool stop_flushing;
+
+        void flushLoop();
+        bool parseIdList(std::string_view text, std::vector<unsigned int>& ids) const;
+        void writeEventLine(const Event& event, std::ostream& output) const;
+        void deleteResourceWithBookings(unsigned int id);
+        void removeStoresExcept(StorageFormat kept) const;
+        bool collectCalendar(const std::string& view, const std::string& date, unsigned int resource_id,
+                             std::string& heading, std::vector<Event>& occurrences, std::string& error) const;
+        void showCalendar(const std::string& view, const std::string& date, unsigned int resource_id);
 
     public:
         CampusSystem();
+        CampusSystem(bool interactive);
         void run();
+        int runBatch(std::istream& input, std::ostream& output);
+        bool executeCommand(const std::string& line, std::ostream& output, bool allow_admin);
         void loadAllData();
-        void saveAllData();
+        bool saveAllData(bool changed_only, std::string& error);
+        bool convertStorage(const std::string& format);
+        bool importCsv(const std::string& kind, const std::string& path);
+        bool archiveEvents(const std::string& before_date);
+        bool writeReport(const std::string& from_date, const std::string& to_date, const std::string& format,
+                         const std::string& day_start, const std::string& day_end, std::ostream& output,
+                         std::string& error) const;
+        bool writeCalendar(const std::string& view, const std::string& date, unsigned int resource_id,
+                           const std::string& format, unsigned int page, std::ostream& output,
+                           std::string& error) const;
         bool isRunning() const;
         ~CampusSystem();
             
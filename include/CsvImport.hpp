@@ -0,0 +1,22 @@
+#ifndef CSVIMPORT_HPP
+#define CSVIMPORT_HPP
+#include <string>
+#include <string_view>
+#include <vector>
+#include <utility>
+#include <ostream>
+
+struct ImportReport {
+    unsigned int imported;
+    std::vector<std::pair<unsigned int, std::string> > rejected;
+
+    ImportReport();
+    void reject(unsigned int line_number, const std::string& reason);
+    void print(std::ostream& output) const;
+};
+
+bool parseCsvLine(std::string_view line, std::vector<std::string>& fields);
+bool parseCsvBool(const std::string& text, bool& value);
+bool isCsvHeader(const std::vector<std::string>& fields, const char* first_column);
+
+#endif
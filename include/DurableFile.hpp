@@ -0,0 +1,48 @@
+#ifndef DURABLEFILE_HPP
+#define DURABLEFILE_HPP
+#include <string>
+#include <string_view>
+#include <cstdio>
+#include <cstdint>
+
+const char* const FAULT_INJECTION_VARIABLE = "CAMPUS_FAULT_AFTER_WRITES";
+const int FAULT_EXIT_CODE = 86;
+
+enum ChecksumState {
+    CHECKSUM_MISSING,
+    CHECKSUM_VALID,
+    CHECKSUM_INVALID
+};
+
+class AtomicFile {
+    private:
+        std::string path;
+        std::string temp_path;
+        std::FILE* file;
+
+        AtomicFile(const AtomicFile& other);
+        AtomicFile& operator=(const AtomicFile& other);
+
+    public:
+        AtomicFile(const std::string& path);
+        ~AtomicFile();
+
+        bool open();
+        bool write(std::string_view data);
+        bool commit();
+        void abort();
+};
+
+uint32_t crc32(std::string_view data);
+void appendChecksum(std::string& line);
+ChecksumState stripChecksum(std::string_view& line);
+
+bool writeBytes(std::FILE* file, std::string_view data);
+bool syncFile(std::FILE* file);
+bool syncDirectoryOf(const std::string& path);
+void crashIfFaultReached();
+void armFaultInjection(long writes);
+
+void quarantineRecord(const std::string& quarantine_file, const std::string& origin, std::string_view raw);
+
+#endif
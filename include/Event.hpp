@@ -6,36 +6,50 @@
 #include <sstream>
 #include <iomanip>
 #include <vector>
+#include "Recurrence.hpp"
+#include "ResourceIdList.hpp"
 
 class Event {
     private:
         unsigned int id;
         std::string title;
-        std::string date;              
-        std::string start_time;        
+        long start_stamp;
         int duration_minutes;
-        std::vector<unsigned int> resource_ids;  
+        ResourceIdList resource_ids;
+        Recurrence recurrence;
 
     public:
         Event();
         Event(unsigned int id, const std::string& title, const std::string& date,
               const std::string& start_time, int duration_minutes, 
-              const std::vector<unsigned int>& resource_ids);  
-        ~Event();
+              const ResourceIdList& resource_ids);
+        Event(unsigned int id, const std::string& title, long start_stamp,
+              int duration_minutes, const ResourceIdList& resource_ids);
 
         unsigned int getId() const;
-        std::string getTitle() const;
+        const std::string& getTitle() const;
         std::string getDate() const;
         std::string getStartTime() const;
+        long getStartStamp() const;
+        long getEndStamp() const;
         int getDurationMinutes() const;
-        std::vector<unsigned int> getResourceIds() const;  
+        const ResourceIdList& getResourceIds() const;
+        const Recurrence& getRecurrence() const;
+        bool isRecurring() const;
+        long getLastEndStamp() const;
+        bool overlapsOccurrence(long start, long end) const;
+        void collectOccurrences(long from, long to, std::vector<long>& starts) const;
         void setTitle(const std::string& title);
         void setDate(const std::string& date);
         void setStartTime(const std::string& start_time);
+        void setStartStamp(long start_stamp);
         void setDurationMinutes(int duration_minutes);
-        void setResourceIds(const std::vector<unsigned int>& resource_ids);  
+        void setResourceIds(const ResourceIdList& resource_ids);
         void addResourceId(unsigned int resource_id); 
         void removeResourceId(unsigned int resource_id); 
+        void replaceResourceId(unsigned int old_id, unsigned int new_id);
+        bool setRecurrence(const Recurrence& recurrence, std::string& error);
+        bool skipOccurrence(long day);
         void displayInfo() const;
         std::string toString() const;
         std::string getEndTime() const;
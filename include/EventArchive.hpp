@@ -0,0 +1,88 @@
+#ifndef EVENTARCHIVE_HPP
+#define EVENTARCHIVE_HPP
+#include "Event.hpp"
+#include "MappedFile.hpp"
+#include <string>
+#include <string_view>
+#include <vector>
+#include <list>
+#include <unordered_map>
+#include <functional>
+#include <mutex>
+#include <cstdint>
+
+class EventArchive {
+    public:
+        static constexpr std::size_t ENTRY_SIZE = 32;
+        static constexpr std::size_t ID_ENTRY_SIZE = 8;
+        static constexpr std::size_t FOOTER_SIZE = 48;
+        static constexpr uint32_t VERSION = 1;
+        static constexpr std::size_t DEFAULT_CACHE_CAPACITY = 4096;
+
+        typedef std::function<bool(std::string_view, Event&)> RecordParser;
+
+    private:
+        struct Segment {
+            std::string_view content;
+            const char* entries;
+            const char* id_table;
+            uint32_t entry_count;
+            uint32_t max_id;
+            long longest_span;
+            long horizon;
+        };
+
+        struct CachedEvent {
+            uint64_t key;
+            Event event;
+        };
+
+        std::string path;
+        RecordParser parse;
+        MappedFile file;
+        std::vector<Segment> segments;
+        uint64_t valid_length;
+        uint32_t entry_count;
+        uint32_t max_id;
+        long horizon;
+        bool damaged;
+        bool torn;
+        std::size_t cache_capacity;
+        mutable std::mutex cache_mutex;
+        mutable std::list<CachedEvent> cache;
+        mutable std::unordered_map<uint64_t, std::list<CachedEvent>::iterator> cache_index;
+
+        EventArchive(const EventArchive& other);
+        EventArchive& operator=(const EventArchive& other);
+
+        bool readSegments(std::string_view view, uint64_t end, std::vector<Segment>& found) const;
+        bool findEntry(const Segment& segment, unsigned int id, uint32_t& entry) const;
+        bool findNewest(unsigned int id, uint32_t& segment, uint32_t& entry) const;
+        bool isShadowed(uint32_t segment, unsigned int id) const;
+        uint32_t firstEntryFrom(const Segment& segment, long start) const;
+        bool readEntry(uint32_t segment, uint32_t entry, Event& event) const;
+        void clearCache();
+
+    public:
+        EventArchive(const std::string& path, RecordParser parse);
+
+        bool open();
+        void close();
+        bool append(std::vector<Event>& archived);
+        bool find(unsigned int id, Event& event) const;
+        bool contains(unsigned int id) const;
+        void collectRange(long range_start, long range_end, std::vector<Event>& found) const;
+        void collectAll(std::vector<Event>& all) const;
+
+        void setCacheCapacity(std::size_t capacity);
+        std::size_t getCachedCount() const;
+        unsigned int size() const;
+        unsigned int getSegmentCount() const;
+        unsigned int getMaxId() const;
+        long getHorizon() const;
+        std::string getPath() const;
+        bool isDamaged() const;
+        bool hasTornTail() const;
+};
+
+#endif
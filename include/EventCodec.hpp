@@ -0,0 +1,25 @@
+#ifndef EVENTCODEC_HPP
+#define EVENTCODEC_HPP
+#include "Event.hpp"
+#include "RecordCodec.hpp"
+#include <string>
+#include <string_view>
+#include <vector>
+
+class EventCodec : public RecordCodec<Event> {
+    private:
+        SqliteTable table;
+
+    public:
+        EventCodec();
+
+        std::string toLine(const Event& event) const override;
+        bool parseLine(std::string_view line, Event& event) const override;
+        void writeSnapshot(const std::vector<const Event*>& events, std::string& content) const override;
+        bool readSnapshot(std::string_view content, std::vector<Event>& events) const override;
+        const SqliteTable& getSqliteTable() const override;
+        void writeRow(const Event& event, SqliteRow& row) const override;
+        bool readRow(const SqliteRow& row, Event& event) const override;
+};
+
+#endif
@@ -3,23 +3,117 @@
 
 #include "Event.hpp"
 #include "ResourceManager.hpp"
+#include "Journal.hpp"
+#include "CsvImport.hpp"
+#include "TrigramIndex.hpp"
+#include "EventCodec.hpp"
+#include "TextStore.hpp"
+#include "BinaryStore.hpp"
+#include "PagedStore.hpp"
+#include "SqliteStore.hpp"
+#include "EventArchive.hpp"
+#include "UtilizationReport.hpp"
+#include "SlabStore.hpp"
 #include <vector>
+#include <map>
+#include <unordered_map>
+#include <unordered_set>
+#include <shared_mutex>
+#include <mutex>
 
 class EventManager {
     private:
-        std::vector<Event> events;
+        struct BookedSlot {
+            long end;
+            unsigned int event_id;
+        };
+
+        struct DayBooking {
+            long start;
+            unsigned int event_id;
+        };
+
+        struct ImportRow {
+            unsigned int line_number;
+            std::string title;
+            long start_stamp;
+            int duration_minutes;
+            std::vector<unsigned int> resource_ids;
+        };
+
+        SlabStore<Event> events;
         ResourceManager* resource_manager;
-        std::string data_file;
+        std::string quarantine_file;
+        bool auto_save;
         unsigned int next_id;
+        unsigned int damaged_count;
+        std::unordered_map<unsigned int, std::multimap<long, BookedSlot> > resource_schedule;
+        std::unordered_map<unsigned int, std::vector<unsigned int> > resource_series;
+        std::map<long, std::vector<DayBooking> > day_bookings;
+        std::vector<unsigned int> series_ids;
+        int longest_duration;
+        std::unordered_map<unsigned int, unsigned int> id_index;
+        std::unordered_multimap<std::string, unsigned int, CaseInsensitiveHash, CaseInsensitiveEqual> title_index;
+        TrigramIndex title_trigrams;
+        Journal journal;
+        EventCodec codec;
+        TextStore<Event> text_store;
+        BinaryStore<Event> binary_store;
+        PagedStore<Event> paged_store;
+        SqliteStore<Event> sqlite_store;
+        StorageBackend<Event>* stores[STORAGE_FORMAT_COUNT];
+        StorageBackend<Event>* backend;
+        EventArchive archive;
+        std::unordered_set<unsigned int> dirty_ids;
+        mutable std::shared_mutex mutex;
+        
+        void indexEvent(const Event& event);
+        void unindexEvent(const Event& event);
+        void rebuildSchedule();
+        void collectSingles(long range_start, long range_end, std::vector<unsigned int>& slots) const;
+        void appendSeriesOccurrences(const std::vector<unsigned int>& ids, long range_start, long range_end,
+                                     std::vector<Event>& occurrences) const;
+        void appendArchivedOccurrences(long range_start, long range_end, unsigned int resource_id,
+                                       std::vector<Event>& occurrences) const;
+        bool archivedConflict(const Event& candidate, unsigned int exclude_event_id) const;
+        bool parseDateRange(const std::string& from_date, const std::string& to_date,
+                            long& range_start, long& range_end, std::string& error) const;
+        void indexLookups(unsigned int slot);
+        void unindexLookups(unsigned int slot);
+        bool findTitleSlot(const std::string& title, unsigned int& slot) const;
+        void rebuildLookups();
+        unsigned int replayJournal();
+        bool journalChange(char operation, const std::string& payload, std::string& error);
+        bool journalChange(char operation, const std::vector<std::string>& payloads, std::string& error);
+        void recordChange(unsigned int id);
+        void compactLargeJournal();
+        void markDirty(unsigned int id);
+        bool compactJournal(std::string& error);
+        bool clearJournal(std::string& error);
+        void adoptRecords(std::vector<Event>& loaded);
+        bool writeStore(StorageBackend<Event>& store, std::string& error);
+        void finishLoad(unsigned int max_id);
+        void quarantine(const std::string& origin, std::string_view raw);
+        bool checkResources(const ResourceIdList& resource_ids, std::string& error) const;
+        bool isValidTitle(const std::string& title) const;
+        bool parseCsvResourceIds(const std::string& text, std::vector<unsigned int>& resource_ids) const;
         
-        bool hasConflict(const std::vector<unsigned int>& resource_ids, const std::string& date, 
-                        const std::string& start_time, int duration_minutes,
-                        unsigned int exclude_event_id = 0) const;
+        void collectBusyIntervals(const std::vector<unsigned int>& resource_ids, long range_start,
+                                  long range_end, std::vector<std::pair<long, long> >& busy) const;
         
-        bool timesOverlap(const std::string& start1, const std::string& end1,
-                        const std::string& start2, const std::string& end2) const;
+        bool conflictsWith(const ResourceIdList& resource_ids, long start_stamp,
+                           int duration_minutes, unsigned int exclude_event_id = 0) const;
+        bool eventConflicts(const Event& candidate, unsigned int exclude_event_id) const;
+        bool seriesOverlap(const Event& series, const Event& other) const;
+        bool usesResource(unsigned int resource_id) const;
+        void collectBookings(unsigned int resource_id, std::vector<unsigned int>& event_ids) const;
+        void discardEvent(unsigned int slot);
+        bool dropEvent(unsigned int slot, std::string& error);
+        std::vector<unsigned int> matchTitle(const std::string& search_lower) const;
         
-        std::string calculateEndTime(const std::string& start_time, int duration_minutes) const;
+        bool timesOverlap(long start1, long end1, long start2, long end2) const;
+        
+        std::string calculateEndTime(long start_stamp, int duration_minutes) const;
         
         std::string toLowercase(const std::string& str) const;
         
@@ -27,12 +121,33 @@ class EventManager {
         bool isValidTime(const std::string& time) const;
 
     public:
+        struct FreeSlot {
+            long start;
+            long end;
+        };
+
         EventManager(ResourceManager* res_manager);
         ~EventManager();
         
+        unsigned int createEvent(const std::string& title, const std::string& date,
+                                 const std::string& start_time, int duration_minutes,
+                                 const std::vector<unsigned int>& resource_ids, std::string& error);
+        unsigned int createEvent(const std::string& title, const std::string& date,
+                                 const std::string& start_time, int duration_minutes,
+                                 const std::vector<unsigned int>& resource_ids,
+                                 const std::string& recurrence_rule, std::string& error);
+        bool modifyEvent(unsigned int id, const std::string& new_title, const std::string& new_date,
+                         const std::string& new_start_time, int new_duration,
+                         const std::vector<unsigned int>& new_resource_ids, std::string& error);
+        bool removeEvent(unsigned int id, std::string& error);
+        bool skipOccurrence(unsigned int id, const std::string& date, std::string& error);
+        bool importFromCsv(const std::string& path, ImportReport& report, std::string& error);
+        bool archiveEvents(const std::string& before_date, unsigned int& archived_count, std::string& error);
+
         void addEvent(const std::string& title, const std::string& date,
                      const std::string& start_time, int duration_minutes, 
-                     const std::vector<unsigned int>& resource_ids);
+                     const std::vector<unsigned int>& resource_ids,
+                     const std::string& recurrence_rule = "");
         void viewAllEvents() const;
         void updateEvent(unsigned int id);
         void updateEventByTitle(const std::string& title);
@@ -46,11 +161,54 @@ class EventManager {
         bool eventExistsByTitle(const std::string& title) const;
         Event* findEvent(unsigned int id);
         Event* findEventByTitle(const std::string& title);
+        const Event* getEvent(unsigned int id) const;
+        SlabHandle getEventHandle(unsigned int id) const;
+        Event* findEvent(SlabHandle handle);
+        const Event* getEvent(SlabHandle handle) const;
+        bool lookupEvent(unsigned int id, Event& event) const;
+        std::vector<unsigned int> matchEventsByTitle(const std::string& title) const;
+        std::vector<FuzzyMatch> fuzzyMatchEventsByTitle(const std::string& title, unsigned int max_results) const;
+        bool listOccurrences(const std::string& from_date, const std::string& to_date,
+                             std::vector<Event>& occurrences, std::string& error) const;
+        bool listResourceOccurrences(unsigned int resource_id, const std::string& from_date, const std::string& to_date,
+                                     std::vector<Event>& occurrences, std::string& error) const;
         
         bool isResourceUsedByEvents(unsigned int resource_id) const;
+        bool modifyResourceGuarded(unsigned int resource_id, const std::string& new_name,
+                                   const std::string& new_type, int new_availability, std::string& error);
+        bool removeResourceGuarded(unsigned int resource_id, bool force, std::string& error);
+        bool reassignResourceGuarded(unsigned int resource_id, unsigned int replacement_id, std::string& error);
+        bool listResourceBookings(unsigned int resource_id, std::vector<Event>& bookings, std::string& error) const;
+        void showResourceBookings(unsigned int resource_id) const;
+        bool hasConflict(const std::vector<unsigned int>& resource_ids, long start_stamp,
+                         int duration_minutes, unsigned int exclude_event_id = 0) const;
+        bool findFreeSlots(const std::vector<unsigned int>& resource_ids, int duration_minutes,
+                           const std::string& from_date, const std::string& to_date,
+                           const std::string& day_start, const std::string& day_end,
+                           unsigned int max_slots, std::vector<FreeSlot>& slots, std::string& error) const;
+        void showFreeSlots(const std::vector<unsigned int>& resource_ids, int duration_minutes,
+                           const std::string& from_date, const std::string& to_date,
+                           const std::string& day_start, const std::string& day_end,
+                           unsigned int max_slots) const;
+        bool buildUtilizationReport(const std::string& from_date, const std::string& to_date,
+                                    const std::string& day_start, const std::string& day_end,
+                                    UtilizationReport& report, std::string& error) const;
         
-        void saveToFile() const;
-        void loadFromFile();
+        void setAutoSave(bool enabled);
+        bool save(std::string& error);
+        bool saveAs(StorageFormat format, std::string& error);
+        bool loadFrom(StorageFormat format);
+        void load();
+        bool flushChanges(std::string& error);
+        StorageFormat getStorageFormat() const;
+        std::string getStorePath(StorageFormat format) const;
+        std::string getQuarantineFile() const;
+        unsigned int getDamagedRecordCount() const;
+        bool hasUnsavedChanges() const;
+        unsigned int getArchivedCount() const;
+        std::string getArchiveFile() const;
+        bool isArchiveDamaged() const;
+        void setArchiveCacheCapacity(std::size_t capacity);
 
         void searchEventById(unsigned int id) const;
         void searchEventByTitle(const std::string& title) const;
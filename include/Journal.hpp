@@ -0,0 +1,31 @@
+#ifndef JOURNAL_HPP
+#define JOURNAL_HPP
+#include <string>
+#include <vector>
+#include <cstdio>
+
+class Journal {
+    private:
+        std::string log_file;
+        std::FILE* stream;
+        unsigned int entry_count;
+
+        Journal(const Journal& other);
+        Journal& operator=(const Journal& other);
+
+    public:
+        static constexpr char PUT = 'P';
+        static constexpr char REMOVE = 'D';
+
+        Journal(const std::string& log_file);
+        ~Journal();
+
+        bool append(char operation, const std::string& payload);
+        bool append(char operation, const std::vector<std::string>& payloads);
+        std::vector<std::string> readEntries(std::vector<std::string>& damaged);
+        bool reset();
+        unsigned int getEntryCount() const;
+        std::string getLogFile() const;
+};
+
+#endif
@@ -0,0 +1,25 @@
+#ifndef MAPPEDFILE_HPP
+#define MAPPEDFILE_HPP
+#include <string>
+#include <string_view>
+
+class MappedFile {
+    private:
+        const char* data;
+        std::size_t length;
+        std::string fallback_buffer;
+        bool is_mapped;
+
+        MappedFile(const MappedFile& other);
+        MappedFile& operator=(const MappedFile& other);
+
+    public:
+        MappedFile();
+        ~MappedFile();
+
+        bool open(const std::string& path);
+        void close();
+        std::string_view view() const;
+};
+
+#endif
@@ -0,0 +1,65 @@
+#ifndef PAGEDFILE_HPP
+#define PAGEDFILE_HPP
+#include <string>
+#include <string_view>
+#include <vector>
+#include <map>
+#include <cstdio>
+#include <utility>
+#include <cstdint>
+#include "MappedFile.hpp"
+
+class PagedFile {
+    public:
+        static constexpr std::size_t PAGE_SIZE = 4096;
+        static constexpr std::size_t PAGE_HEADER_SIZE = 16;
+        static constexpr std::size_t ENTRY_HEADER_SIZE = 8;
+        static constexpr uint32_t VERSION = 1;
+
+    private:
+        struct PageInfo {
+            uint32_t used;
+            uint32_t span;
+        };
+
+        std::string path;
+        std::string batch_path;
+        char magic[4];
+        std::vector<PageInfo> pages;
+        std::vector<uint32_t> record_pages;
+        std::vector<uint32_t> empty_pages;
+        std::vector<std::pair<uint32_t, unsigned int> > stale_entries;
+        uint32_t fill_page;
+        uint64_t sequence;
+        std::size_t last_write_bytes;
+        MappedFile mapped;
+
+        uint32_t findPage(unsigned int id) const;
+        void setPage(unsigned int id, uint32_t page);
+        std::string* loadPage(std::FILE* file, uint32_t page, std::map<uint32_t, std::string>& cache);
+        bool removeEntry(std::FILE* file, uint32_t page, unsigned int id, std::map<uint32_t, std::string>& cache);
+        bool placeEntry(std::FILE* file, uint32_t page, unsigned int id, const std::string& payload,
+                        std::map<uint32_t, std::string>& cache, bool& placed);
+        uint32_t allocatePage(std::size_t entry_size, std::map<uint32_t, std::string>& cache);
+        void writeHeaderPage(std::string& out) const;
+        bool load(std::string_view content, std::vector<std::string_view>& records,
+                  std::vector<uint32_t>& damaged_pages);
+
+    public:
+        PagedFile(const std::string& path, const char* magic);
+
+        bool recover();
+        bool open(std::vector<std::string_view>& records, std::vector<std::string>& damaged);
+        void close();
+        bool commit(const std::vector<std::pair<unsigned int, std::string> >& puts,
+                    const std::vector<unsigned int>& removals);
+        bool rewrite(const std::vector<std::pair<unsigned int, std::string> >& records);
+        bool isAttached() const;
+        void clear();
+
+        std::string getPath() const;
+        std::size_t getLastWriteBytes() const;
+        uint32_t getPageCount() const;
+};
+
+#endif
@@ -0,0 +1,94 @@
+#ifndef PAGEDSTORE_HPP
+#define PAGEDSTORE_HPP
+#include "StorageBackend.hpp"
+#include "RecordCodec.hpp"
+#include "PagedFile.hpp"
+#include "DurableFile.hpp"
+#include <string>
+#include <string_view>
+#include <vector>
+#include <utility>
+#include <algorithm>
+#include <filesystem>
+
+template <typename Record>
+class PagedStore : public StorageBackend<Record> {
+    private:
+        PagedFile file;
+        const RecordCodec<Record>& codec;
+
+        void encode(const std::vector<const Record*>& records,
+                    std::vector<std::pair<unsigned int, std::string> >& lines) const {
+            lines.reserve(records.size());
+            for (unsigned int i = 0; i < records.size(); i++) {
+                lines.push_back(std::make_pair(records[i]->getId(), codec.toLine(*records[i])));
+                appendChecksum(lines.back().second);
+            }
+        }
+
+    public:
+        PagedStore(const std::string& path, const char* magic, const RecordCodec<Record>& codec)
+            : file(path, magic), codec(codec) {
+        }
+
+        bool load(std::vector<Record>& records, std::vector<DamagedRecord>& damaged) override {
+            records.clear();
+            damaged.clear();
+            std::vector<std::string_view> lines;
+            std::vector<std::string> damaged_pages;
+            if (!file.open(lines, damaged_pages)) {
+                return false;
+            }
+
+            for (unsigned int i = 0; i < damaged_pages.size(); i++) {
+                damaged.push_back(DamagedRecord{damaged_pages[i], "unreadable page"});
+            }
+
+            records.reserve(lines.size());
+            for (unsigned int i = 0; i < lines.size(); i++) {
+                std::string_view line = lines[i];
+                records.emplace_back();
+                if (stripChecksum(line) == CHECKSUM_INVALID || !codec.parseLine(line, records.back())) {
+                    records.pop_back();
+                    damaged.push_back(DamagedRecord{file.getPath(), std::string(lines[i])});
+                }
+            }
+            file.close();
+
+            std::sort(records.begin(), records.end(), [](const Record& a, const Record& b) {
+                return a.getId() < b.getId();
+            });
+            return true;
+        }
+
+        bool rewrite(const std::vector<const Record*>& records) override {
+            std::vector<std::pair<unsigned int, std::string> > lines;
+            encode(records, lines);
+            return file.rewrite(lines);
+        }
+
+        bool commit(const std::vector<const Record*>& puts, const std::vector<unsigned int>& removals) override {
+            std::vector<std::pair<unsigned int, std::string> > lines;
+            encode(puts, lines);
+            return file.commit(lines, removals);
+        }
+
+        bool canCommitChanges() const override {
+            return file.isAttached();
+        }
+
+        bool exists() const override {
+            std::error_code error;
+            return std::filesystem::exists(file.getPath(), error);
+        }
+
+        StorageFormat getFormat() const override {
+            return PAGED_STORAGE;
+        }
+
+        std::string getPath() const override {
+            return file.getPath();
+        }
+};
+
+#endif
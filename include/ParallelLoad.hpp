@@ -0,0 +1,89 @@
+#ifndef PARALLELLOAD_HPP
+#define PARALLELLOAD_HPP
+#include <string>
+#include <string_view>
+#include <vector>
+#include <functional>
+#include <iterator>
+
+const char* const LOAD_THREADS_VARIABLE = "CAMPUS_LOAD_THREADS";
+const std::size_t MIN_CHUNK_BYTES = 256 * 1024;
+
+struct DamagedLine {
+    unsigned int line_number;
+    std::string_view raw;
+};
+
+template <typename Record>
+struct ParsedChunk {
+    std::vector<Record> records;
+    std::vector<DamagedLine> damaged;
+    unsigned int max_id;
+    unsigned int line_count;
+};
+
+unsigned int loaderThreadCount();
+unsigned int partCount(std::size_t work_size, std::size_t min_part_size);
+void splitAtLines(std::string_view content, unsigned int chunk_count, std::vector<std::string_view>& chunks);
+void runParallel(unsigned int task_count, const std::function<void(unsigned int)>& task);
+
+template <typename Record, typename Parser>
+void parseLinesInParallel(std::string_view content, Parser parse, std::vector<Record>& records,
+                          std::vector<DamagedLine>& damaged, unsigned int& max_id) {
+    std::vector<std::string_view> chunks;
+    splitAtLines(content, partCount(content.size(), MIN_CHUNK_BYTES), chunks);
+    std::vector<ParsedChunk<Record> > parsed(chunks.size());
+
+    runParallel(chunks.size(), [&](unsigned int c) {
+        std::string_view text = chunks[c];
+        ParsedChunk<Record>& chunk = parsed[c];
+        chunk.max_id = 0;
+        chunk.line_count = 0;
+        chunk.records.reserve(text.size() / 32 + 1);
+        std::string_view::size_type line_start = 0;
+
+        while (line_start < text.size()) {
+            std::string_view::size_type line_end = text.find('\n', line_start);
+            if (line_end == std::string_view::npos) {
+                line_end = text.size();
+            }
+
+            std::string_view line = text.substr(line_start, line_end - line_start);
+            line_start = line_end + 1;
+            chunk.line_count++;
+            if (line.empty()) {
+                continue;
+            }
+
+            chunk.records.emplace_back();
+            if (!parse(line, chunk.records.back())) {
+                chunk.records.pop_back();
+                chunk.damaged.push_back(DamagedLine{chunk.line_count, line});
+                continue;
+            }
+            chunk.max_id = (chunk.records.back().getId() > chunk.max_id) ? chunk.records.back().getId() : chunk.max_id;
+        }
+    });
+
+    std::size_t total = 0;
+    for (unsigned int c = 0; c < parsed.size(); c++) {
+        total += parsed[c].records.size();
+    }
+    records.clear();
+    records.reserve(total);
+    damaged.clear();
+    max_id = 0;
+
+    unsigned int lines_before = 0;
+    for (unsigned int c = 0; c < parsed.size(); c++) {
+        records.insert(records.end(), std::make_move_iterator(parsed[c].records.begin()),
+                       std::make_move_iterator(parsed[c].records.end()));
+        for (unsigned int i = 0; i < parsed[c].damaged.size(); i++) {
+            damaged.push_back(DamagedLine{lines_before + parsed[c].damaged[i].line_number, parsed[c].damaged[i].raw});
+        }
+        max_id = (parsed[c].max_id > max_id) ? parsed[c].max_id : max_id;
+        lines_before += parsed[c].line_count;
+    }
+}
+
+#endif
@@ -0,0 +1,22 @@
+#ifndef RECORDCODEC_HPP
+#define RECORDCODEC_HPP
+#include "SqliteRow.hpp"
+#include <string>
+#include <string_view>
+#include <vector>
+
+template <typename Record>
+class RecordCodec {
+    public:
+        virtual ~RecordCodec() {}
+
+        virtual std::string toLine(const Record& record) const = 0;
+        virtual bool parseLine(std::string_view line, Record& record) const = 0;
+        virtual void writeSnapshot(const std::vector<const Record*>& records, std::string& content) const = 0;
+        virtual bool readSnapshot(std::string_view content, std::vector<Record>& records) const = 0;
+        virtual const SqliteTable& getSqliteTable() const = 0;
+        virtual void writeRow(const Record& record, SqliteRow& row) const = 0;
+        virtual bool readRow(const SqliteRow& row, Record& record) const = 0;
+};
+
+#endif
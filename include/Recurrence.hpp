@@ -0,0 +1,54 @@
+#ifndef RECURRENCE_HPP
+#define RECURRENCE_HPP
+#include <string>
+#include <string_view>
+#include <vector>
+
+class Recurrence {
+    public:
+        enum Frequency {
+            NONE,
+            DAILY,
+            WEEKLY
+        };
+
+        static constexpr unsigned int MAX_INTERVAL = 52;
+        static constexpr unsigned int MAX_COUNT = 10000;
+        static constexpr long NO_END = 0x7FFFFFFFFFFFL;
+
+    private:
+        Frequency frequency;
+        unsigned int interval;
+        unsigned int weekdays;
+        unsigned int count;
+        long until_day;
+        std::vector<long> exceptions;
+        long first_day;
+        long period_anchor;
+        long last_day;
+        std::vector<int> day_offsets;
+
+    public:
+        Recurrence();
+
+        bool parse(std::string_view rule, std::string& error);
+        bool anchor(long first_day, std::string& error);
+        bool addException(long day);
+
+        bool isRecurring() const;
+        bool occursOn(long day) const;
+        long nextOn(long day) const;
+        long getFirstDay() const;
+        long getLastDay() const;
+        long getSettledDay() const;
+        long getPeriodDays() const;
+        unsigned int getExceptionCount() const;
+
+        std::string toString() const;
+        std::string describe() const;
+};
+
+long stampToDay(long stamp);
+int weekdayOfDay(long day);
+
+#endif
@@ -14,11 +14,10 @@ class Resource {
         Resource();
         Resource(unsigned int id, const std::string& name, 
                 const std::string& type, bool available = true);
-        ~Resource();
 
         unsigned int getId() const;
-        std::string getName() const;
-        std::string getType() const;
+        const std::string& getName() const;
+        const std::string& getType() const;
         bool isAvailable() const;
 
         void setName(const std::string& name);
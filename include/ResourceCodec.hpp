@@ -0,0 +1,25 @@
+#ifndef RESOURCECODEC_HPP
+#define RESOURCECODEC_HPP
+#include "Resource.hpp"
+#include "RecordCodec.hpp"
+#include <string>
+#include <string_view>
+#include <vector>
+
+class ResourceCodec : public RecordCodec<Resource> {
+    private:
+        SqliteTable table;
+
+    public:
+        ResourceCodec();
+
+        std::string toLine(const Resource& resource) const override;
+        bool parseLine(std::string_view line, Resource& resource) const override;
+        void writeSnapshot(const std::vector<const Resource*>& resources, std::string& content) const override;
+        bool readSnapshot(std::string_view content, std::vector<Resource>& resources) const override;
+        const SqliteTable& getSqliteTable() const override;
+        void writeRow(const Resource& resource, SqliteRow& row) const override;
+        bool readRow(const SqliteRow& row, Resource& resource) const override;
+};
+
+#endif
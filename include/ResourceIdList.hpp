@@ -0,0 +1,46 @@
+#ifndef RESOURCEIDLIST_HPP
+#define RESOURCEIDLIST_HPP
+#include <vector>
+#include <cstdint>
+
+class ResourceIdList {
+    public:
+        static const uint32_t INLINE_CAPACITY = 4;
+
+    private:
+        uint32_t count;
+        uint32_t capacity;
+        union {
+            unsigned int inline_ids[INLINE_CAPACITY];
+            unsigned int* heap_ids;
+        };
+
+        bool isInline() const;
+        void assign(const unsigned int* ids, uint32_t id_count);
+        void release();
+        void grow(uint32_t min_capacity);
+
+    public:
+        ResourceIdList();
+        ResourceIdList(const std::vector<unsigned int>& ids);
+        ResourceIdList(const ResourceIdList& other);
+        ResourceIdList(ResourceIdList&& other) noexcept;
+        ResourceIdList& operator=(const ResourceIdList& other);
+        ResourceIdList& operator=(ResourceIdList&& other) noexcept;
+        ~ResourceIdList();
+
+        unsigned int size() const;
+        bool empty() const;
+        unsigned int operator[](unsigned int index) const;
+        const unsigned int* data() const;
+        const unsigned int* begin() const;
+        const unsigned int* end() const;
+        bool contains(unsigned int id) const;
+        std::vector<unsigned int> toVector() const;
+
+        void push_back(unsigned int id);
+        void erase(unsigned int index);
+        void clear();
+};
+
+#endif
@@ -1,21 +1,82 @@
 #ifndef RESOURCEMANAGER_HPP
 #define RESOURCEMANAGER_HPP
 #include "Resource.hpp"
+#include "outils.hpp"
+#include "Journal.hpp"
+#include "CsvImport.hpp"
+#include "TrigramIndex.hpp"
+#include "ResourceCodec.hpp"
+#include "TextStore.hpp"
+#include "BinaryStore.hpp"
+#include "PagedStore.hpp"
+#include "SqliteStore.hpp"
+#include "SlabStore.hpp"
 #include <vector>
+#include <unordered_map>
+#include <unordered_set>
+#include <shared_mutex>
+#include <mutex>
 #include <string>
 #include <fstream>
 #include <sstream>
 
 class ResourceManager {
     private:
-        std::vector<Resource> resources;
-        std::string data_file;
+        SlabStore<Resource> resources;
+        std::string quarantine_file;
+        bool auto_save;
         unsigned int next_id;
+        unsigned int damaged_count;
+        std::unordered_map<unsigned int, unsigned int> id_index;
+        std::unordered_multimap<std::string, unsigned int, CaseInsensitiveHash, CaseInsensitiveEqual> name_index;
+        TrigramIndex name_trigrams;
+        TrigramIndex type_trigrams;
+
+        Journal journal;
+        ResourceCodec codec;
+        TextStore<Resource> text_store;
+        BinaryStore<Resource> binary_store;
+        PagedStore<Resource> paged_store;
+        SqliteStore<Resource> sqlite_store;
+        StorageBackend<Resource>* stores[STORAGE_FORMAT_COUNT];
+        StorageBackend<Resource>* backend;
+        std::unordered_set<unsigned int> dirty_ids;
+        mutable std::shared_mutex mutex;
+
+        void indexResource(unsigned int slot);
+        void unindexResource(unsigned int slot);
+        bool findNameSlot(const std::string& name, unsigned int& slot) const;
+        void rebuildIndexes();
+        void indexSearchTerms(const Resource& resource);
+        void unindexSearchTerms(const Resource& resource);
+        void rebuildSearchIndex();
+        std::vector<unsigned int> matchText(const TrigramIndex& trigrams, const std::string& term,
+                                            const std::string& (Resource::*field)() const) const;
+        unsigned int replayJournal();
+        bool journalChange(char operation, const std::string& payload, std::string& error);
+        bool journalChange(char operation, const std::vector<std::string>& payloads, std::string& error);
+        void recordChange(unsigned int id);
+        void compactLargeJournal();
+        void markDirty(unsigned int id);
+        bool compactJournal(std::string& error);
+        bool clearJournal(std::string& error);
+        void adoptRecords(std::vector<Resource>& loaded);
+        bool writeStore(StorageBackend<Resource>& store, std::string& error);
+        void finishLoad(unsigned int max_id);
+        void quarantine(const std::string& origin, std::string_view raw);
+        bool isValidText(const std::string& text) const;
 
     public:
         ResourceManager();
         ~ResourceManager();
 
+        unsigned int createResource(const std::string& name, const std::string& type,
+                                    bool is_available, std::string& error);
+        bool modifyResource(unsigned int id, const std::string& new_name, const std::string& new_type,
+                            int new_availability, bool can_change_availability, std::string& error);
+        bool removeResource(unsigned int id, std::string& error);
+        bool importFromCsv(const std::string& path, ImportReport& report, std::string& error);
+
         void addResource(const std::string& name, const std::string& type, bool is_available);
         void viewAllResources() const;
         void updateResource(unsigned int id, bool can_change_availability);
@@ -28,13 +89,31 @@ class ResourceManager {
         bool resourceExistsByName(const std::string& name) const;
         Resource* findResource(unsigned int id); 
         Resource* findResourceByName(const std::string& name);
+        const Resource* getResource(unsigned int id) const;
+        SlabHandle getResourceHandle(unsigned int id) const;
+        Resource* findResource(SlabHandle handle);
+        const Resource* getResource(SlabHandle handle) const;
+        bool lookupResource(unsigned int id, Resource& resource) const;
+        void listResources(std::vector<Resource>& snapshot) const;
+        std::vector<unsigned int> matchResourcesByName(const std::string& name) const;
+        std::vector<unsigned int> matchResourcesByType(const std::string& type) const;
+        std::vector<FuzzyMatch> fuzzyMatchResourcesByName(const std::string& name, unsigned int max_results) const;
         
         std::string toLowercase(const std::string& str) const; 
         void searchResourceById(unsigned int id) const;
         void searchResourceByName(const std::string& name) const;
         void searchResourceByType(const std::string& type) const;
-        void saveToFile() const;
-        void loadFromFile();
+        void setAutoSave(bool enabled);
+        bool save(std::string& error);
+        bool saveAs(StorageFormat format, std::string& error);
+        bool loadFrom(StorageFormat format);
+        void load();
+        bool flushChanges(std::string& error);
+        StorageFormat getStorageFormat() const;
+        std::string getStorePath(StorageFormat format) const;
+        std::string getQuarantineFile() const;
+        unsigned int getDamagedRecordCount() const;
+        bool hasUnsavedChanges() const;
 };
 
 #endif
\ No newline at end of file
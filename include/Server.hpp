@@ -0,0 +1,48 @@
+#ifndef SERVER_HPP
+#define SERVER_HPP
+#include "CampusSystem.hpp"
+#include <string>
+#include <sstream>
+#include <vector>
+#include <unordered_map>
+
+class Server {
+    private:
+        struct Connection {
+            int fd;
+            std::string input;
+            std::string output;
+            unsigned int interest;
+            bool peer_closed;
+            bool queued;
+        };
+
+        CampusSystem& campus_system;
+        std::string socket_path;
+        unsigned int worker_count;
+        int listen_fd;
+
+        Server(const Server& other);
+        Server& operator=(const Server& other);
+
+        void runWorker();
+        void serveConnection(int epoll_fd, std::unordered_map<int, Connection>& connections, int fd,
+                             std::vector<int>& queued, std::ostringstream& response);
+        bool readRequests(Connection& connection, std::ostringstream& response);
+        bool flushOutput(int epoll_fd, Connection& connection);
+
+    public:
+        static const std::size_t MAX_REQUEST_LENGTH = 65536;
+        static const std::size_t MAX_PENDING_OUTPUT = 65536;
+        static const unsigned int MAX_REQUESTS_PER_WAKEUP = 64;
+
+        Server(CampusSystem& system, const std::string& path, unsigned int workers);
+        ~Server();
+
+        bool start(std::string& error);
+        void run();
+        void stop();
+        std::string getSocketPath() const;
+};
+
+#endif
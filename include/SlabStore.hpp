@@ -0,0 +1,193 @@
+#ifndef SLABSTORE_HPP
+#define SLABSTORE_HPP
+#include <vector>
+#include <memory>
+#include <cstdint>
+#include <utility>
+
+struct SlabHandle {
+    uint32_t slot;
+    uint32_t generation;
+};
+
+const SlabHandle NULL_HANDLE = {0, 0};
+
+template <typename T>
+class SlabStore {
+    public:
+        static const uint32_t SLAB_SHIFT = 10;
+        static const uint32_t SLAB_SIZE = 1u << SLAB_SHIFT;
+
+        class const_iterator {
+            private:
+                const SlabStore* store;
+                uint32_t slot;
+
+                void skipFree() {
+                    while (slot < store->slotCount() && !store->isLive(slot)) {
+                        slot++;
+                    }
+                }
+
+            public:
+                const_iterator(const SlabStore* store, uint32_t slot) : store(store), slot(slot) {
+                    skipFree();
+                }
+
+                const T& operator*() const {
+                    return (*store)[slot];
+                }
+
+                const T* operator->() const {
+                    return &(*store)[slot];
+                }
+
+                const_iterator& operator++() {
+                    slot++;
+                    skipFree();
+                    return *this;
+                }
+
+                bool operator==(const const_iterator& other) const {
+                    return slot == other.slot;
+                }
+
+                bool operator!=(const const_iterator& other) const {
+                    return slot != other.slot;
+                }
+
+                uint32_t getSlot() const {
+                    return slot;
+                }
+        };
+
+    private:
+        struct Slab {
+            T records[SLAB_SIZE];
+            uint32_t generations[SLAB_SIZE];
+        };
+
+        std::vector<std::unique_ptr<Slab> > slabs;
+        std::vector<uint32_t> free_slots;
+        uint32_t slot_count;
+        uint32_t live_count;
+
+        SlabStore(const SlabStore& other);
+        SlabStore& operator=(const SlabStore& other);
+
+        uint32_t& generationAt(uint32_t slot) {
+            return slabs[slot >> SLAB_SHIFT]->generations[slot & (SLAB_SIZE - 1)];
+        }
+
+        uint32_t generationAt(uint32_t slot) const {
+            return slabs[slot >> SLAB_SHIFT]->generations[slot & (SLAB_SIZE - 1)];
+        }
+
+        uint32_t claimSlot() {
+            uint32_t slot;
+            if (!free_slots.empty()) {
+                slot = free_slots.back();
+                free_slots.pop_back();
+            } else {
+                slot = slot_count++;
+                if ((slot >> SLAB_SHIFT) >= slabs.size()) {
+                    slabs.push_back(std::unique_ptr<Slab>(new Slab()));
+                }
+            }
+            generationAt(slot)++;
+            live_count++;
+            return slot;
+        }
+
+    public:
+        SlabStore() : slot_count(0), live_count(0) {
+        }
+
+        SlabHandle insert(const T& record) {
+            uint32_t slot = claimSlot();
+            (*this)[slot] = record;
+            return handleAt(slot);
+        }
+
+        SlabHandle insert(T&& record) {
+            uint32_t slot = claimSlot();
+            (*this)[slot] = std::move(record);
+            return handleAt(slot);
+        }
+
+        void erase(uint32_t slot) {
+            (*this)[slot] = T();
+            generationAt(slot)++;
+            free_slots.push_back(slot);
+            live_count--;
+        }
+
+        void clear() {
+            for (uint32_t slot = 0; slot < slot_count; slot++) {
+                if (isLive(slot)) {
+                    (*this)[slot] = T();
+                    generationAt(slot)++;
+                }
+            }
+            free_slots.clear();
+            slot_count = 0;
+            live_count = 0;
+        }
+
+        void reserve(std::size_t count) {
+            while (slabs.size() * SLAB_SIZE < count) {
+                slabs.push_back(std::unique_ptr<Slab>(new Slab()));
+            }
+        }
+
+        T* get(SlabHandle handle) {
+            if (handle.slot >= slot_count || (handle.generation & 1) == 0 ||
+                generationAt(handle.slot) != handle.generation) {
+                return NULL;
+            }
+            return &(*this)[handle.slot];
+        }
+
+        const T* get(SlabHandle handle) const {
+            return const_cast<SlabStore*>(this)->get(handle);
+        }
+
+        T& operator[](uint32_t slot) {
+            return slabs[slot >> SLAB_SHIFT]->records[slot & (SLAB_SIZE - 1)];
+        }
+
+        const T& operator[](uint32_t slot) const {
+            return slabs[slot >> SLAB_SHIFT]->records[slot & (SLAB_SIZE - 1)];
+        }
+
+        bool isLive(uint32_t slot) const {
+            return (generationAt(slot) & 1) == 1;
+        }
+
+        SlabHandle handleAt(uint32_t slot) const {
+            SlabHandle handle = {slot, generationAt(slot)};
+            return handle;
+        }
+
+        std::size_t size() const {
+            return live_count;
+        }
+
+        bool empty() const {
+            return live_count == 0;
+        }
+
+        uint32_t slotCount() const {
+            return slot_count;
+        }
+
+        const_iterator begin() const {
+            return const_iterator(this, 0);
+        }
+
+        const_iterator end() const {
+            return const_iterator(this, slot_count);
+        }
+};
+
+#endif
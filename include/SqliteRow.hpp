@@ -0,0 +1,46 @@
+#ifndef SQLITEROW_HPP
+#define SQLITEROW_HPP
+#include <string>
+#include <string_view>
+#include <vector>
+#include <cstdint>
+
+struct sqlite3_stmt;
+
+struct SqliteColumn {
+    std::string name;
+    std::string type;
+    bool indexed;
+};
+
+struct SqliteTable {
+    std::string name;
+    std::vector<SqliteColumn> columns;
+    std::string link_table;
+    std::string link_owner;
+    std::string link_column;
+};
+
+class SqliteRow {
+    private:
+        sqlite3_stmt* statement;
+        int first_column;
+        unsigned int id;
+        std::vector<unsigned int> links;
+
+    public:
+        SqliteRow(sqlite3_stmt* statement, int first_column);
+
+        void setId(unsigned int id);
+        void setInteger(unsigned int column, int64_t value);
+        void setText(unsigned int column, std::string_view value);
+        void setNull(unsigned int column);
+        unsigned int getId() const;
+        int64_t getInteger(unsigned int column) const;
+        std::string_view getText(unsigned int column) const;
+        bool isNull(unsigned int column) const;
+        std::vector<unsigned int>& getLinks();
+        const std::vector<unsigned int>& getLinks() const;
+};
+
+#endif
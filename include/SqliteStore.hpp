@@ -0,0 +1,105 @@
+#ifndef SQLITESTORE_HPP
+#define SQLITESTORE_HPP
+#include "StorageBackend.hpp"
+#include "RecordCodec.hpp"
+#include "SqliteRow.hpp"
+#include <string>
+#include <vector>
+#include <functional>
+#include <filesystem>
+
+struct sqlite3;
+
+class SqliteDatabase {
+    public:
+        static constexpr int BUSY_TIMEOUT_MS = 5000;
+
+        typedef std::function<void(unsigned int index, SqliteRow& row)> RowWriter;
+        typedef std::function<bool(const SqliteRow& row)> RowReader;
+
+    private:
+        std::string path;
+        SqliteTable table;
+        std::string table_sql;
+        std::string index_sql;
+        std::string select_sql;
+        std::string insert_sql;
+        std::string delete_sql;
+        std::string link_select_sql;
+        std::string link_insert_sql;
+        std::string link_delete_sql;
+        bool attached;
+
+        SqliteDatabase(const SqliteDatabase& other);
+        SqliteDatabase& operator=(const SqliteDatabase& other);
+
+        sqlite3* connect(bool create) const;
+        bool hasTable(sqlite3* db) const;
+        bool putRows(sqlite3* db, unsigned int count, const RowWriter& write, bool replace) const;
+        bool removeRows(sqlite3* db, const std::vector<unsigned int>& ids) const;
+        bool readRows(sqlite3* db, const RowReader& read, std::vector<DamagedRecord>& damaged) const;
+
+    public:
+        SqliteDatabase(const std::string& path, const SqliteTable& table);
+
+        bool read(const RowReader& read, std::vector<DamagedRecord>& damaged);
+        bool commit(unsigned int count, const RowWriter& write, const std::vector<unsigned int>& removals);
+        bool rewrite(unsigned int count, const RowWriter& write);
+        bool isAttached() const;
+        std::string getPath() const;
+};
+
+template <typename Record>
+class SqliteStore : public StorageBackend<Record> {
+    private:
+        SqliteDatabase database;
+        const RecordCodec<Record>& codec;
+
+    public:
+        SqliteStore(const std::string& path, const RecordCodec<Record>& codec)
+            : database(path, codec.getSqliteTable()), codec(codec) {
+        }
+
+        bool load(std::vector<Record>& records, std::vector<DamagedRecord>& damaged) override {
+            records.clear();
+            return database.read([&](const SqliteRow& row) {
+                records.emplace_back();
+                if (!codec.readRow(row, records.back())) {
+                    records.pop_back();
+                    return false;
+                }
+                return true;
+            }, damaged);
+        }
+
+        bool rewrite(const std::vector<const Record*>& records) override {
+            return database.rewrite(records.size(), [&](unsigned int index, SqliteRow& row) {
+                codec.writeRow(*records[index], row);
+            });
+        }
+
+        bool commit(const std::vector<const Record*>& puts, const std::vector<unsigned int>& removals) override {
+            return database.commit(puts.size(), [&](unsigned int index, SqliteRow& row) {
+                codec.writeRow(*puts[index], row);
+            }, removals);
+        }
+
+        bool canCommitChanges() const override {
+            return database.isAttached();
+        }
+
+        bool exists() const override {
+            std::error_code error;
+            return std::filesystem::exists(database.getPath(), error);
+        }
+
+        StorageFormat getFormat() const override {
+            return SQLITE_STORAGE;
+        }
+
+        std::string getPath() const override {
+            return database.getPath();
+        }
+};
+
+#endif
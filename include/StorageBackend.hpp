@@ -0,0 +1,37 @@
+#ifndef STORAGEBACKEND_HPP
+#define STORAGEBACKEND_HPP
+#include <string>
+#include <vector>
+
+enum StorageFormat {
+    TEXT_STORAGE,
+    BINARY_STORAGE,
+    PAGED_STORAGE,
+    SQLITE_STORAGE
+};
+
+const unsigned int STORAGE_FORMAT_COUNT = 4;
+const StorageFormat STORAGE_LOAD_ORDER[STORAGE_FORMAT_COUNT] = {
+    SQLITE_STORAGE, PAGED_STORAGE, BINARY_STORAGE, TEXT_STORAGE
+};
+
+struct DamagedRecord {
+    std::string origin;
+    std::string raw;
+};
+
+template <typename Record>
+class StorageBackend {
+    public:
+        virtual ~StorageBackend() {}
+
+        virtual bool load(std::vector<Record>& records, std::vector<DamagedRecord>& damaged) = 0;
+        virtual bool rewrite(const std::vector<const Record*>& records) = 0;
+        virtual bool commit(const std::vector<const Record*>& puts, const std::vector<unsigned int>& removals) = 0;
+        virtual bool canCommitChanges() const = 0;
+        virtual bool exists() const = 0;
+        virtual StorageFormat getFormat() const = 0;
+        virtual std::string getPath() const = 0;
+};
+
+#endif
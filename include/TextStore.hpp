@@ -0,0 +1,78 @@
+#ifndef TEXTSTORE_HPP
+#define TEXTSTORE_HPP
+#include "StorageBackend.hpp"
+#include "RecordCodec.hpp"
+#include "MappedFile.hpp"
+#include "ParallelLoad.hpp"
+#include "DurableFile.hpp"
+#include "BinarySnapshot.hpp"
+#include <string>
+#include <string_view>
+#include <vector>
+#include <filesystem>
+
+template <typename Record>
+class TextStore : public StorageBackend<Record> {
+    private:
+        std::string path;
+        const RecordCodec<Record>& codec;
+
+    public:
+        TextStore(const std::string& path, const RecordCodec<Record>& codec) : path(path), codec(codec) {
+        }
+
+        bool load(std::vector<Record>& records, std::vector<DamagedRecord>& damaged) override {
+            records.clear();
+            damaged.clear();
+            MappedFile file;
+            if (!file.open(path)) {
+                return true;
+            }
+
+            std::vector<DamagedLine> damaged_lines;
+            unsigned int max_id;
+            parseLinesInParallel(file.view(), [this](std::string_view line, Record& record) {
+                return stripChecksum(line) != CHECKSUM_INVALID && codec.parseLine(line, record);
+            }, records, damaged_lines, max_id);
+
+            for (unsigned int i = 0; i < damaged_lines.size(); i++) {
+                damaged.push_back(DamagedRecord{path + " line " + std::to_string(damaged_lines[i].line_number),
+                                                std::string(damaged_lines[i].raw)});
+            }
+            return true;
+        }
+
+        bool rewrite(const std::vector<const Record*>& records) override {
+            std::string content;
+            for (unsigned int i = 0; i < records.size(); i++) {
+                std::string line = codec.toLine(*records[i]);
+                appendChecksum(line);
+                content += line;
+                content += '\n';
+            }
+            return writeFileAtomically(path, content);
+        }
+
+        bool commit(const std::vector<const Record*>&, const std::vector<unsigned int>&) override {
+            return false;
+        }
+
+        bool canCommitChanges() const override {
+            return false;
+        }
+
+        bool exists() const override {
+            std::error_code error;
+            return std::filesystem::exists(path, error);
+        }
+
+        StorageFormat getFormat() const override {
+            return TEXT_STORAGE;
+        }
+
+        std::string getPath() const override {
+            return path;
+        }
+};
+
+#endif
@@ -0,0 +1,50 @@
+#ifndef TRIGRAMINDEX_HPP
+#define TRIGRAMINDEX_HPP
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+#include <utility>
+
+struct FuzzyMatch {
+    unsigned int id;
+    int distance;
+    unsigned int length_gap;
+};
+
+class TrigramIndex {
+    private:
+        std::unordered_map<unsigned int, std::vector<unsigned int> > postings;
+        unsigned int max_id;
+
+        void collectTrigrams(std::string_view text, std::vector<unsigned int>& keys) const;
+
+    public:
+        static const unsigned int TRIGRAM_LENGTH = 3;
+        static const unsigned int TRIGRAMS_PER_EDIT = TRIGRAM_LENGTH + 1;
+        static const int MAX_TYPO_DISTANCE = 2;
+
+        TrigramIndex();
+        void add(unsigned int id, std::string_view text);
+        void addAll(const std::vector<std::pair<unsigned int, std::string_view> >& entries);
+        void remove(unsigned int id, std::string_view text);
+        void clear();
+        bool findCandidates(std::string_view lowered_term, std::vector<unsigned int>& ids) const;
+        int findSimilarCandidates(std::string_view lowered_term, std::vector<unsigned int>& ids) const;
+};
+
+class FuzzyRanker {
+    private:
+        std::string_view term;
+        int distance_limit;
+        unsigned int result_limit;
+        unsigned int distance_counts[TrigramIndex::MAX_TYPO_DISTANCE + 1];
+        std::vector<FuzzyMatch> matches;
+        std::vector<int> rows;
+
+    public:
+        FuzzyRanker(std::string_view lowered_term, int max_distance, unsigned int max_results);
+        void consider(unsigned int id, std::string_view text);
+        std::vector<FuzzyMatch> finish();
+};
+
+#endif
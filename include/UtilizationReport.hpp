@@ -0,0 +1,87 @@
+#ifndef UTILIZATIONREPORT_HPP
+#define UTILIZATIONREPORT_HPP
+#include "Resource.hpp"
+#include "ResourceIdList.hpp"
+#include <string>
+#include <vector>
+#include <ostream>
+#include <cstdint>
+
+struct ResourceUsage {
+    unsigned int id;
+    std::string name;
+    std::string type;
+    unsigned int bookings;
+    long booked_minutes;
+    long peak_day;
+    long peak_day_minutes;
+    long peak_week_minutes;
+};
+
+struct TypeUsage {
+    std::string type;
+    unsigned int resource_count;
+    unsigned int idle_count;
+    long booked_minutes;
+};
+
+struct ContendedSlot {
+    long start_stamp;
+    long busy_minutes;
+};
+
+class UtilizationReport {
+    public:
+        static constexpr unsigned int MAX_DAYS = 731;
+        static constexpr std::size_t MAX_DAY_CELLS = 64 * 1024 * 1024;
+        static constexpr unsigned int CONTENDED_SLOT_COUNT = 10;
+        static constexpr unsigned int HEATMAP_CELLS = 7 * 24;
+
+    private:
+        struct HourChunk {
+            unsigned int day;
+            unsigned int hour_cell;
+            unsigned int heat_cell;
+            unsigned int minutes;
+        };
+
+        long first_day;
+        unsigned int day_count;
+        int day_start;
+        int day_end;
+        std::vector<unsigned int> resource_slots;
+        std::vector<unsigned int> resource_types;
+        std::vector<uint16_t> day_minutes;
+        std::vector<uint32_t> hour_minutes;
+        std::vector<long> type_heatmaps;
+        std::vector<HourChunk> chunks;
+
+        std::vector<ResourceUsage> resources;
+        std::vector<TypeUsage> types;
+        std::vector<long> heatmap;
+        std::vector<ContendedSlot> contended;
+
+        long getOpenMinutes() const;
+        std::string describeRange() const;
+
+    public:
+        UtilizationReport();
+
+        void begin(const std::vector<Resource>& campus_resources, long first_day, unsigned int day_count,
+                   int day_start, int day_end);
+        void addBooking(const ResourceIdList& resource_ids, long start, long end);
+        void finish();
+
+        const std::vector<ResourceUsage>& getResources() const;
+        const std::vector<TypeUsage>& getTypes() const;
+        const std::vector<long>& getHeatmap() const;
+        const std::vector<ContendedSlot>& getContendedSlots() const;
+        unsigned int getIdleCount() const;
+        long getBookedMinutes() const;
+
+        void print(std::ostream& output) const;
+        void writeCsv(std::ostream& output) const;
+        void writeJson(std::ostream& output) const;
+};
+
+#endif
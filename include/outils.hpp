@@ -3,9 +3,19 @@
 #include <iostream>
 #include <cstdlib>
 #include <string>
+#include <string_view>
 #include <cctype>
 #include <limits>
 #include <sstream>
+#include <vector>
+
+struct CaseInsensitiveHash {
+    std::size_t operator()(const std::string& str) const;
+};
+
+struct CaseInsensitiveEqual {
+    bool operator()(const std::string& left, const std::string& right) const;
+};
 
 void clearScreen();
 void systemMainMenu();
@@ -16,4 +26,21 @@ void systemResourceSearchMenu();
 void systemEventSearchMenu();
 void sleepSeconds(int seconds);
 
+long daysFromCivil(int year, int month, int day);
+void civilFromDays(long days, int& year, int& month, int& day);
+long toMinuteStamp(std::string_view date, std::string_view time);
+std::string stampToDate(long stamp);
+std::string stampToTime(long stamp);
+
+unsigned int splitFields(std::string_view line, char delimiter, std::string_view* fields, unsigned int max_fields);
+bool parseUnsigned(std::string_view text, unsigned int& value);
+bool parseInt(std::string_view text, int& value);
+void appendJsonString(std::string& output, std::string_view text);
+std::string jsonString(std::string_view text);
+
+char foldCase(char c);
+bool containsIgnoreCase(std::string_view text, std::string_view lowered_term);
+int boundedSubstringDistance(std::string_view text, std::string_view lowered_pattern, int max_distance,
+                             std::vector<int>& rows);
+
 #endif
\ No newline at end of file
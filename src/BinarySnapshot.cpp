@@ -0,0 +1,133 @@
+#include "BinarySnapshot.hpp"
+#include "DurableFile.hpp"
+#include <cstring>
+
+StringTableBuilder::StringTableBuilder() {
+    offsets.push_back(0);
+}
+
+uint32_t StringTableBuilder::intern(const std::string& str) {
+    std::unordered_map<std::string, uint32_t>::const_iterator it = lookup.find(str);
+    if (it != lookup.end()) {
+        return it->second;
+    }
+    
+    uint32_t index = offsets.size() - 1;
+    bytes += str;
+    offsets.push_back(bytes.size());
+    lookup[str] = index;
+    return index;
+}
+
+uint32_t StringTableBuilder::getCount() const {
+    return offsets.size() - 1;
+}
+
+uint32_t StringTableBuilder::getByteSize() const {
+    return bytes.size();
+}
+
+void StringTableBuilder::appendTo(std::string& out) const {
+    for (unsigned int i = 0; i < offsets.size(); i++) {
+        putU32(out, offsets[i]);
+    }
+    out += bytes;
+}
+
+StringTableView::StringTableView() {
+    offsets = NULL;
+    bytes = NULL;
+    count = 0;
+    byte_size = 0;
+}
+
+bool StringTableView::attach(std::string_view region, uint32_t count, uint32_t byte_size) {
+    std::size_t offsets_size = (static_cast<std::size_t>(count) + 1) * 4;
+    if (region.size() != offsets_size + byte_size) {
+        return false;
+    }
+    
+    this->offsets = region.data();
+    this->bytes = region.data() + offsets_size;
+    this->count = count;
+    this->byte_size = byte_size;
+    return true;
+}
+
+bool StringTableView::get(uint32_t index, std::string_view& out) const {
+    if (index >= count) {
+        return false;
+    }
+    
+    uint32_t begin = readU32(offsets + index * 4);
+    uint32_t end = readU32(offsets + (index + 1) * 4);
+    if (begin > end || end > byte_size) {
+        return false;
+    }
+    
+    out = std::string_view(bytes + begin, end - begin);
+    return true;
+}
+
+void putU32(std::string& out, uint32_t value) {
+    char buffer[4];
+    for (int i = 0; i < 4; i++) {
+        buffer[i] = static_cast<char>((value >> (8 * i)) & 0xFF);
+    }
+    out.append(buffer, 4);
+}
+
+void putI32(std::string& out, int32_t value) {
+    putU32(out, static_cast<uint32_t>(value));
+}
+
+void putI64(std::string& out, int64_t value) {
+    uint64_t bits = static_cast<uint64_t>(value);
+    putU32(out, static_cast<uint32_t>(bits & 0xFFFFFFFFULL));
+    putU32(out, static_cast<uint32_t>(bits >> 32));
+}
+
+uint32_t readU32(const char* in) {
+    const unsigned char* bytes = reinterpret_cast<const unsigned char*>(in);
+    return static_cast<uint32_t>(bytes[0]) | (static_cast<uint32_t>(bytes[1]) << 8) |
+           (static_cast<uint32_t>(bytes[2]) << 16) | (static_cast<uint32_t>(bytes[3]) << 24);
+}
+
+int32_t readI32(const char* in) {
+    return static_cast<int32_t>(readU32(in));
+}
+
+int64_t readI64(const char* in) {
+    uint64_t low = readU32(in);
+    uint64_t high = readU32(in + 4);
+    return static_cast<int64_t>(low | (high << 32));
+}
+
+void writeSnapshotHeader(std::string& out, const SnapshotHeader& header) {
+    out.append(header.magic, 4);
+    putU32(out, header.version);
+    putU32(out, header.record_count);
+    putU32(out, header.id_count);
+    putU32(out, header.string_count);
+    putU32(out, header.string_bytes);
+}
+
+bool readSnapshotHeader(std::string_view content, const char* magic, uint32_t max_version, SnapshotHeader& header) {
+    if (content.size() < SNAPSHOT_HEADER_SIZE || std::memcmp(content.data(), magic, 4) != 0) {
+        return false;
+    }
+    
+    std::memcpy(header.magic, content.data(), 4);
+    header.version = readU32(content.data() + 4);
+    header.record_count = readU32(content.data() + 8);
+    header.id_count = readU32(content.data() + 12);
+    header.string_count = readU32(content.data() + 16);
+    header.string_bytes = readU32(content.data() + 20);
+    
+    return header.version >= 1 && header.version <= max_version;
+}
+
+bool writeFileAtomically(const std::string& path, const std::string& content) {
+    AtomicFile file(path);
+    return file.open() && file.write(content) && file.commit();
+}
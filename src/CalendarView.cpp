@@ -0,0 +1,175 @@
+#include "CalendarView.hpp"
+#include "Recurrence.hpp"
+#include "outils.hpp"
+#include <charconv>
+#include <climits>
+
+static const char* const WEEKDAY_NAMES[7] = {"Mon", "Tue", "Wed", "Thu", "Fri", "Sat", "Sun"};
+
+CalendarView::CalendarView(const ResourceManager& resource_manager, bool json_lines, unsigned int page_size)
+    : resource_manager(resource_manager), json_lines(json_lines), page_size(page_size) {
+    buffer.reserve(FLUSH_BYTES + 1024);
+}
+
+const std::string& CalendarView::resourceName(unsigned int id) {
+    std::unordered_map<unsigned int, std::string>::iterator it = resource_names.find(id);
+    if (it != resource_names.end()) {
+        return it->second;
+    }
+
+    Resource resource;
+    std::string name = resource_manager.lookupResource(id, resource) ? resource.getName() : "#" + std::to_string(id);
+    return resource_names.emplace(id, name).first->second;
+}
+
+void CalendarView::appendNumber(long value) {
+    char digits[24];
+    std::to_chars_result result = std::to_chars(digits, digits + sizeof(digits), value);
+    buffer.append(digits, result.ptr);
+}
+
+void CalendarView::appendClock(long stamp) {
+    int minute_of_day = static_cast<int>(stamp - stampToDay(stamp) * 1440);
+    char clock[5] = {'0', '0', ':', '0', '0'};
+    clock[0] = static_cast<char>('0' + (minute_of_day / 60) / 10);
+    clock[1] = static_cast<char>('0' + (minute_of_day / 60) % 10);
+    clock[3] = static_cast<char>('0' + (minute_of_day % 60) / 10);
+    clock[4] = static_cast<char>('0' + (minute_of_day % 60) % 10);
+    buffer.append(clock, sizeof(clock));
+}
+
+void CalendarView::appendText(const Event& occurrence) {
+    long start = occurrence.getStartStamp();
+    long end = occurrence.getEndStamp();
+    long extra_days = stampToDay(end - 1) - stampToDay(start);
+
+    buffer += "  ";
+    appendClock(start);
+    buffer += '-';
+    appendClock(end);
+    if (extra_days > 0) {
+        buffer += " (+";
+        appendNumber(extra_days);
+        buffer += "d)";
+    }
+    buffer += "  #";
+    appendNumber(occurrence.getId());
+    buffer += "  ";
+    buffer += occurrence.getTitle();
+
+    const ResourceIdList& resource_ids = occurrence.getResourceIds();
+    if (!resource_ids.empty()) {
+        buffer += "  [";
+        for (unsigned int i = 0; i < resource_ids.size(); i++) {
+            if (i > 0) {
+                buffer += ", ";
+            }
+            buffer += resourceName(resource_ids[i]);
+        }
+        buffer += ']';
+    }
+    buffer += '\n';
+}
+
+void CalendarView::appendJson(const Event& occurrence, const std::string& date) {
+    buffer += "{\"id\":";
+    appendNumber(occurrence.getId());
+    buffer += ",\"title\":";
+    appendJsonString(buffer, occurrence.getTitle());
+    buffer += ",\"date\":\"";
+    buffer += date;
+    buffer += "\",\"start\":\"";
+    appendClock(occurrence.getStartStamp());
+    buffer += "\",\"end\":\"";
+    appendClock(occurrence.getEndStamp());
+    buffer += "\",\"duration\":";
+    appendNumber(occurrence.getDurationMinutes());
+    buffer += ",\"resources\":[";
+
+    const ResourceIdList& resource_ids = occurrence.getResourceIds();
+    for (unsigned int i = 0; i < resource_ids.size(); i++) {
+        buffer += (i > 0) ? ",{\"id\":" : "{\"id\":";
+        appendNumber(resource_ids[i]);
+        buffer += ",\"name\":";
+        appendJsonString(buffer, resourceName(resource_ids[i]));
+        buffer += '}';
+    }
+    buffer += "]}\n";
+}
+
+void CalendarView::flush(std::ostream& output) {
+    output.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+    buffer.clear();
+}
+
+unsigned int CalendarView::getPageCount(std::size_t occurrence_count) const {
+    if (page_size == 0 || occurrence_count == 0) {
+        return 1;
+    }
+    return static_cast<unsigned int>((occurrence_count + page_size - 1) / page_size);
+}
+
+bool CalendarView::write(const std::string& heading, const std::vector<Event>& occurrences, unsigned int page,
+                         std::ostream& output, std::string& error) {
+    unsigned int page_count = getPageCount(occurrences.size());
+    if (page > page_count) {
+        error = "Page " + std::to_string(page) + " is out of range (1-" + std::to_string(page_count) + ").";
+        return false;
+    }
+
+    std::size_t first = 0;
+    std::size_t last = occurrences.size();
+    if (page > 0 && page_size > 0) {
+        first = static_cast<std::size_t>(page - 1) * page_size;
+        if (last > first + page_size) {
+            last = first + page_size;
+        }
+    }
+
+    buffer.clear();
+    if (!json_lines) {
+        buffer += heading;
+        buffer += '\n';
+        if (page > 0) {
+            buffer += "Page ";
+            appendNumber(page);
+            buffer += " of ";
+            appendNumber(page_count);
+            buffer += ", ";
+        }
+        appendNumber(static_cast<long>(occurrences.size()));
+        buffer += " occurrence(s)\n";
+        if (occurrences.empty()) {
+            buffer += "No events scheduled.\n";
+        }
+    }
+
+    long current_day = LONG_MIN;
+    std::string date;
+    for (std::size_t i = first; i < last; i++) {
+        long day = stampToDay(occurrences[i].getStartStamp());
+        if (day != current_day) {
+            current_day = day;
+            date = stampToDate(day * 1440);
+            if (!json_lines) {
+                buffer += '\n';
+                buffer += WEEKDAY_NAMES[weekdayOfDay(day)];
+                buffer += ' ';
+                buffer += date;
+                buffer += '\n';
+            }
+        }
+
+        if (json_lines) {
+            appendJson(occurrences[i], date);
+        } else {
+            appendText(occurrences[i]);
+        }
+        if (buffer.size() >= FLUSH_BYTES) {
+            flush(output);
+        }
+    }
+
+    flush(output);
+    return true;
+}
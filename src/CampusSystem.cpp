@@ -1,13 +1,42 @@
 #include "CampusSystem.hpp"
+#include "CalendarView.hpp"
 #include "outils.hpp"
 #include <limits>
 #include <sstream>
 #include <cstdlib>
+#include <cstdio>
+#include <chrono>
+#include <ctime>
+#include <iomanip>
+#include <algorithm>
 
-CampusSystem::CampusSystem() : event_manager(&resource_manager) {
+static const int FLUSH_INTERVAL_SECONDS = 2;
+
+CampusSystem::CampusSystem() : CampusSystem(true) {
+}
+
+CampusSystem::CampusSystem(bool interactive) : event_manager(&resource_manager) {
     is_running = false;
-    resource_manager.loadFromFile();
-    event_manager.loadFromFile();
+    is_interactive = interactive;
+    stop_flushing = false;
+    loadAllData();
+    flush_thread = std::thread(&CampusSystem::flushLoop, this);
+}
+
+void CampusSystem::flushLoop() {
+    std::unique_lock<std::mutex> lock(flush_mutex);
+    while (!flush_wakeup.wait_for(lock, std::chrono::seconds(FLUSH_INTERVAL_SECONDS),
+                                  [this]() { return stop_flushing; })) {
+        lock.unlock();
+        std::string error;
+        if (!resource_manager.flushChanges(error)) {
+            std::cerr << "Warning: " << error << std::endl;
+        }
+        if (!event_manager.flushChanges(error)) {
+            std::cerr << "Warning: " << error << std::endl;
+        }
+        lock.lock();
+    }
 }
 
 bool CampusSystem::isNumericInput(const std::string& input) const {
@@ -292,11 +321,11 @@ void CampusSystem::handleResourceMenu() {
                         unsigned int id = stringToUInt(identifier);
                         if (event_manager.isResourceUsedByEvents(id)) {
                             std::cout << "Warning: This resource is currently used by one or more events." << std::endl;
-                            std::cout << "Deleting it will affect those events. Continue? (y/N): ";
+                            std::cout << "Deleting it removes it from those events and deletes events left without resources. Continue? (y/N): ";
                             std::string final_confirm;
                             std::getline(std::cin, final_confirm);
                             if (final_confirm == "y" || final_confirm == "Y") {
-                                resource_manager.deleteResource(id);
+                                deleteResourceWithBookings(id);
                             } else {
                                 std::cout << "Deletion cancelled." << std::endl;
                             }
@@ -309,11 +338,11 @@ void CampusSystem::handleResourceMenu() {
                             unsigned int id = res->getId();
                             if (event_manager.isResourceUsedByEvents(id)) {
                                 std::cout << "Warning: This resource is currently used by one or more events." << std::endl;
-                                std::cout << "Deleting it will affect those events. Continue? (y/N): ";
+                                std::cout << "Deleting it removes it from those events and deletes events left without resources. Continue? (y/N): ";
                                 std::string final_confirm;
                                 std::getline(std::cin, final_confirm);
                                 if (final_confirm == "y" || final_confirm == "Y") {
-                                    resource_manager.deleteResourceByName(identifier);
+                                    deleteResourceWithBookings(id);
                                 } else {
                                     std::cout << "Deletion cancelled." << std::endl;
                                 }
@@ -427,12 +456,34 @@ void CampusSystem::handleResourceMenu() {
                 }
                 break;
             }
-            case 6:
+            case 6: {
+                std::cout << "\n=== RESOURCE BOOKINGS ===" << std::endl;
+                std::cout << "Enter resource ID or Name: ";
+                std::string identifier;
+                std::getline(std::cin, identifier);
+                
+                if (isNumericInput(identifier)) {
+                    event_manager.showResourceBookings(stringToUInt(identifier));
+                } else {
+                    Resource* res = resource_manager.findResourceByName(identifier);
+                    if (res != NULL) {
+                        event_manager.showResourceBookings(res->getId());
+                    } else {
+                        std::cout << "Error: Resource with name '" << identifier << "' not found!" << std::endl;
+                    }
+                }
+                
+                std::cout << "\nPress Enter to continue...";
+                std::cin.get();
+                clearScreen();
+                break;
+            }
+            case 7:
                 clearScreen();
                 in_resource_menu = false;
                 break;
             default:
-                std::cout << "Error: Invalid option. Please choose 1-6." << std::endl;
+                std::cout << "Error: Invalid option. Please choose 1-7." << std::endl;
                 std::cout << "\nPress Enter to try again...";
                 std::cin.get();
                 clearScreen();
@@ -479,7 +530,7 @@ void CampusSystem::handleEventMenu() {
                     break;
                 }
                 
-                std::string title, date, start_time, duration_str;
+                std::string title, date, start_time, duration_str, recurrence_rule;
                 int duration = 0;
                 std::vector<unsigned int> resource_ids;
                 
@@ -543,6 +594,9 @@ void CampusSystem::handleEventMenu() {
                     valid_input = true;
                 }
                 
+                std::cout << "Repeat rule (e.g., FREQ=WEEKLY;BYDAY=MO,WE;COUNT=15, press Enter for none): ";
+                std::getline(std::cin, recurrence_rule);
+                
                 valid_input = false;
                 while (!valid_input) {
                     resource_ids = event_manager.selectMultipleResourcesInteractive();
@@ -556,7 +610,7 @@ void CampusSystem::handleEventMenu() {
                     valid_input = true;
                 }
                 
-                event_manager.addEvent(title, date, start_time, duration, resource_ids);
+                event_manager.addEvent(title, date, start_time, duration, resource_ids, recurrence_rule);
                 
                 std::cout << "\nPress Enter to continue...";
                 std::cin.get();
@@ -709,12 +763,73 @@ void CampusSystem::handleEventMenu() {
                 }
                 break;
             }
-            case 6:
+            case 6: {
+                std::cout << "\n=== FIND FREE TIME SLOTS ===" << std::endl;
+                
+                if (resource_manager.getResourceCount() == 0) {
+                    std::cout << "\nNo resources available! Please add resources first." << std::endl;
+                    std::cout << "\nPress Enter to continue...";
+                    std::cin.get();
+                    clearScreen();
+                    break;
+                }
+                
+                std::vector<unsigned int> resource_ids = event_manager.selectMultipleResourcesInteractive();
+                std::string duration_str, from_date, to_date, day_start, day_end;
+                
+                std::cout << "Enter duration in minutes: ";
+                std::getline(std::cin, duration_str);
+                std::cout << "Enter first date [YYYY-MM-DD]: ";
+                std::getline(std::cin, from_date);
+                std::cout << "Enter last date [YYYY-MM-DD]: ";
+                std::getline(std::cin, to_date);
+                std::cout << "Enter working day start [HH:MM] (press Enter for none): ";
+                std::getline(std::cin, day_start);
+                if (!day_start.empty()) {
+                    std::cout << "Enter working day end [HH:MM]: ";
+                    std::getline(std::cin, day_end);
+                }
+                
+                if (!isNumericInput(duration_str) || duration_str.empty()) {
+                    std::cout << "Error: Duration must be a number!" << std::endl;
+                } else {
+                    event_manager.showFreeSlots(resource_ids, stringToUInt(duration_str), from_date, to_date,
+                                                day_start, day_end, 5);
+                }
+                
+                std::cout << "\nPress Enter to continue...";
+                std::cin.get();
+                clearScreen();
+                break;
+            }
+            case 7: {
+                std::cout << "\n=== CALENDAR VIEW ===" << std::endl;
+                std::string view, date, resource_input;
+                
+                std::cout << "Enter view (day/week): ";
+                std::getline(std::cin, view);
+                std::cout << "Enter date [YYYY-MM-DD]: ";
+                std::getline(std::cin, date);
+                std::cout << "Enter resource ID for a room calendar (press Enter for all): ";
+                std::getline(std::cin, resource_input);
+                
+                if (!resource_input.empty() && (!isNumericInput(resource_input) || stringToUInt(resource_input) == 0)) {
+                    std::cout << "Error: Resource ID must be a positive number!" << std::endl;
+                } else {
+                    showCalendar(view, date, resource_input.empty() ? 0 : stringToUInt(resource_input));
+                }
+                
+                std::cout << "\nPress Enter to continue...";
+                std::cin.get();
+                clearScreen();
+                break;
+            }
+            case 8:
                 clearScreen();
                 in_event_menu = false;
                 break;
             default:
-                std::cout << "Error: Invalid option. Please choose 1-6." << std::endl;
+                std::cout << "Error: Invalid option. Please choose 1-8." << std::endl;
                 std::cout << "\nPress Enter to try again...";
                 std::cin.get();
                 clearScreen();
@@ -731,14 +846,579 @@ void CampusSystem::run(){
     }
 }
 
-void CampusSystem::saveAllData() {
-    resource_manager.saveToFile();
-    event_manager.saveToFile();
+int CampusSystem::runBatch(std::istream& input, std::ostream& output) {
+    resource_manager.setAutoSave(false);
+    event_manager.setAutoSave(false);
+    
+    std::string line;
+    int failed_commands = 0;
+    
+    while (std::getline(input, line)) {
+        if (!line.empty() && line[line.length() - 1] == '\r') {
+            line.erase(line.length() - 1);
+        }
+        if (line.empty() || line[0] == '#') {
+            continue;
+        }
+        if (!executeCommand(line, output, true)) {
+            failed_commands++;
+        }
+    }
+    
+    std::string error;
+    if (!saveAllData(true, error)) {
+        output << "ERROR " << error << '\n';
+        failed_commands++;
+    }
+    output.flush();
+    resource_manager.setAutoSave(true);
+    event_manager.setAutoSave(true);
+    return failed_commands;
+}
+
+bool CampusSystem::parseIdList(std::string_view text, std::vector<unsigned int>& ids) const {
+    ids.clear();
+    std::string_view::size_type id_start = 0;
+    
+    while (id_start < text.size()) {
+        std::string_view::size_type id_end = text.find(',', id_start);
+        if (id_end == std::string_view::npos) {
+            id_end = text.size();
+        }
+        
+        unsigned int id;
+        if (!parseUnsigned(text.substr(id_start, id_end - id_start), id)) {
+            return false;
+        }
+        ids.push_back(id);
+        id_start = id_end + 1;
+    }
+    return true;
+}
+
+void CampusSystem::deleteResourceWithBookings(unsigned int id) {
+    std::string error;
+    if (event_manager.removeResourceGuarded(id, true, error)) {
+        std::cout << "Resource deleted successfully. Its bookings were updated." << std::endl;
+    } else {
+        std::cout << "Error: " << error << std::endl;
+    }
+}
+
+void CampusSystem::writeEventLine(const Event& event, std::ostream& output) const {
+    output << event.toString() << '\n';
+}
+
+bool CampusSystem::executeCommand(const std::string& line, std::ostream& output, bool allow_admin) {
+    std::string_view fields[8];
+    unsigned int field_count = splitFields(line, '|', fields, 8);
+    if (field_count == 0 || field_count > 8) {
+        output << "ERROR Malformed command\n";
+        return false;
+    }
+    
+    std::string_view command = fields[0];
+    std::string error;
+    unsigned int id = 0;
+    
+    if (!allow_admin && (command == "import-resources" || command == "import-events" ||
+                         command == "archive" || command == "save")) {
+        error = "Command is only available in batch mode: " + std::string(command);
+    } else if (command == "add-resource" && (field_count == 3 || field_count == 4)) {
+        bool is_available = field_count == 3 || fields[3] == "1";
+        id = resource_manager.createResource(std::string(fields[1]), std::string(fields[2]), is_available, error);
+        if (id != 0) {
+            output << "OK " << id << '\n';
+            return true;
+        }
+    } else if (command == "update-resource" && field_count >= 2 && field_count <= 5) {
+        if (!parseUnsigned(fields[1], id)) {
+            error = "Invalid resource ID";
+        } else {
+            int new_availability = (field_count < 5 || fields[4].empty()) ? -1 : (fields[4] == "1" ? 1 : 0);
+            std::string new_name = field_count > 2 ? std::string(fields[2]) : "";
+            std::string new_type = field_count > 3 ? std::string(fields[3]) : "";
+            
+            if (event_manager.modifyResourceGuarded(id, new_name, new_type, new_availability, error)) {
+                output << "OK " << id << '\n';
+                return true;
+            }
+        }
+    } else if (command == "delete-resource" && (field_count == 2 || field_count == 3)) {
+        if (!parseUnsigned(fields[1], id)) {
+            error = "Invalid resource ID";
+        } else if (event_manager.removeResourceGuarded(id, field_count == 3 && fields[2] == "force", error)) {
+            output << "OK " << id << '\n';
+            return true;
+        }
+    } else if (command == "delete-resource" && field_count == 4 && fields[2] == "reassign") {
+        unsigned int replacement_id;
+        if (!parseUnsigned(fields[1], id) || !parseUnsigned(fields[3], replacement_id)) {
+            error = "Invalid resource ID";
+        } else if (event_manager.reassignResourceGuarded(id, replacement_id, error)) {
+            output << "OK " << id << '\n';
+            return true;
+        }
+    } else if (command == "bookings" && field_count == 2) {
+        std::vector<Event> bookings;
+        if (!parseUnsigned(fields[1], id)) {
+            error = "Invalid resource ID";
+        } else if (event_manager.listResourceBookings(id, bookings, error)) {
+            output << "OK " << bookings.size() << '\n';
+            for (unsigned int i = 0; i < bookings.size(); i++) {
+                writeEventLine(bookings[i], output);
+            }
+            return true;
+        }
+    } else if (command == "add-event" && (field_count == 6 || field_count == 7)) {
+        int duration;
+        std::vector<unsigned int> resource_ids;
+        if (!parseInt(fields[4], duration)) {
+            error = "Duration must be a number!";
+        } else if (!parseIdList(fields[5], resource_ids)) {
+            error = "Invalid resource ID list";
+        } else {
+            std::string recurrence_rule = field_count == 7 ? std::string(fields[6]) : "";
+            id = event_manager.createEvent(std::string(fields[1]), std::string(fields[2]), std::string(fields[3]),
+                                           duration, resource_ids, recurrence_rule, error);
+            if (id != 0) {
+                output << "OK " << id << '\n';
+                return true;
+            }
+        }
+    } else if (command == "update-event" && field_count >= 2 && field_count <= 7) {
+        int duration = 0;
+        std::vector<unsigned int> resource_ids;
+        if (!parseUnsigned(fields[1], id)) {
+            error = "Invalid event ID";
+        } else if (field_count > 5 && !fields[5].empty() && !parseInt(fields[5], duration)) {
+            error = "Duration must be a number!";
+        } else if (field_count > 6 && !parseIdList(fields[6], resource_ids)) {
+            error = "Invalid resource ID list";
+        } else {
+            std::string new_title = field_count > 2 ? std::string(fields[2]) : "";
+            std::string new_date = field_count > 3 ? std::string(fields[3]) : "";
+            std::string new_time = field_count > 4 ? std::string(fields[4]) : "";
+            
+            if (event_manager.modifyEvent(id, new_title, new_date, new_time, duration, resource_ids, error)) {
+                output << "OK " << id << '\n';
+                return true;
+            }
+        }
+    } else if (command == "delete-event" && field_count == 2) {
+        if (!parseUnsigned(fields[1], id)) {
+            error = "Invalid event ID";
+        } else if (event_manager.removeEvent(id, error)) {
+            output << "OK " << id << '\n';
+            return true;
+        }
+    } else if (command == "skip-occurrence" && field_count == 3) {
+        if (!parseUnsigned(fields[1], id)) {
+            error = "Invalid event ID";
+        } else if (event_manager.skipOccurrence(id, std::string(fields[2]), error)) {
+            output << "OK " << id << '\n';
+            return true;
+        }
+    } else if (command == "occurrences" && (field_count == 3 || field_count == 4)) {
+        std::vector<Event> occurrences;
+        bool listed = false;
+        if (field_count == 3) {
+            listed = event_manager.listOccurrences(std::string(fields[1]), std::string(fields[2]), occurrences, error);
+        } else if (!parseUnsigned(fields[3], id)) {
+            error = "Invalid resource ID";
+        } else {
+            listed = event_manager.listResourceOccurrences(id, std::string(fields[1]), std::string(fields[2]),
+                                                           occurrences, error);
+        }
+        if (listed) {
+            output << "OK " << occurrences.size() << '\n';
+            for (unsigned int i = 0; i < occurrences.size(); i++) {
+                writeEventLine(occurrences[i], output);
+            }
+            return true;
+        }
+    } else if (command == "get-resource" && field_count == 2) {
+        Resource resource;
+        if (parseUnsigned(fields[1], id) && resource_manager.lookupResource(id, resource)) {
+            output << "OK 1\n" << resource.toString() << '\n';
+            return true;
+        }
+        error = "Resource not found";
+    } else if (command == "get-event" && field_count == 2) {
+        Event event;
+        if (parseUnsigned(fields[1], id) && event_manager.lookupEvent(id, event)) {
+            output << "OK 1\n";
+            writeEventLine(event, output);
+            return true;
+        }
+        error = "Event not found";
+    } else if (command == "search-resources" && field_count == 3 && (fields[1] == "name" || fields[1] == "type")) {
+        std::string term(fields[2]);
+        std::vector<unsigned int> found_ids = fields[1] == "name" ? resource_manager.matchResourcesByName(term)
+                                                                  : resource_manager.matchResourcesByType(term);
+        std::vector<Resource> found;
+        found.reserve(found_ids.size());
+        for (unsigned int i = 0; i < found_ids.size(); i++) {
+            found.emplace_back();
+            if (!resource_manager.lookupResource(found_ids[i], found.back())) {
+                found.pop_back();
+            }
+        }
+        output << "OK " << found.size() << '\n';
+        for (unsigned int i = 0; i < found.size(); i++) {
+            output << found[i].toString() << '\n';
+        }
+        return true;
+    } else if (command == "search-events" && field_count == 2) {
+        std::vector<unsigned int> found_ids = event_manager.matchEventsByTitle(std::string(fields[1]));
+        std::vector<Event> found;
+        found.reserve(found_ids.size());
+        for (unsigned int i = 0; i < found_ids.size(); i++) {
+            found.emplace_back();
+            if (!event_manager.lookupEvent(found_ids[i], found.back())) {
+                found.pop_back();
+            }
+        }
+        output << "OK " << found.size() << '\n';
+        for (unsigned int i = 0; i < found.size(); i++) {
+            writeEventLine(found[i], output);
+        }
+        return true;
+    } else if ((command == "fuzzy-resources" || command == "fuzzy-events") && (field_count == 2 || field_count == 3)) {
+        unsigned int max_results = 5;
+        if (field_count == 3 && (!parseUnsigned(fields[2], max_results) || max_results == 0)) {
+            error = "Invalid result count";
+        } else if (command == "fuzzy-resources") {
+            std::vector<FuzzyMatch> matches = resource_manager.fuzzyMatchResourcesByName(std::string(fields[1]), max_results);
+            std::ostringstream records;
+            unsigned int record_count = 0;
+            Resource resource;
+            for (unsigned int i = 0; i < matches.size(); i++) {
+                if (resource_manager.lookupResource(matches[i].id, resource)) {
+                    records << matches[i].distance << '|' << resource.toString() << '\n';
+                    record_count++;
+                }
+            }
+            output << "OK " << record_count << '\n' << records.str();
+            return true;
+        } else {
+            std::vector<FuzzyMatch> matches = event_manager.fuzzyMatchEventsByTitle(std::string(fields[1]), max_results);
+            std::ostringstream records;
+            unsigned int record_count = 0;
+            Event event;
+            for (unsigned int i = 0; i < matches.size(); i++) {
+                if (event_manager.lookupEvent(matches[i].id, event)) {
+                    records << matches[i].distance << '|' << event.toString() << '\n';
+                    record_count++;
+                }
+            }
+            output << "OK " << record_count << '\n' << records.str();
+            return true;
+        }
+    } else if (command == "free-slots" && (field_count == 5 || field_count == 7 || field_count == 8)) {
+        std::vector<unsigned int> resource_ids;
+        std::vector<EventManager::FreeSlot> slots;
+        int duration = 0;
+        unsigned int max_slots = 1;
+        
+        if (!parseIdList(fields[1], resource_ids)) {
+            error = "Invalid resource ID list";
+        } else if (!parseInt(fields[2], duration)) {
+            error = "Invalid duration";
+        } else if (field_count == 8 && (!parseUnsigned(fields[7], max_slots) || max_slots == 0)) {
+            error = "Invalid slot count";
+        } else if (event_manager.findFreeSlots(resource_ids, duration, std::string(fields[3]), std::string(fields[4]),
+                                               std::string(fields[5]), std::string(fields[6]), max_slots, slots, error)) {
+            output << "OK " << slots.size() << '\n';
+            for (unsigned int i = 0; i < slots.size(); i++) {
+                output << stampToDate(slots[i].start) << '|' << stampToTime(slots[i].start) << '|'
+                       << stampToDate(slots[i].end) << '|' << stampToTime(slots[i].end) << '\n';
+            }
+            return true;
+        }
+    } else if (command == "report" && (field_count == 4 || field_count == 6)) {
+        std::ostringstream report;
+        if (writeReport(std::string(fields[1]), std::string(fields[2]), std::string(fields[3]),
+                        field_count == 6 ? std::string(fields[4]) : "", field_count == 6 ? std::string(fields[5]) : "",
+                        report, error)) {
+            std::string lines = report.str();
+            output << "OK " << std::count(lines.begin(), lines.end(), '\n') << '\n' << lines;
+            return true;
+        }
+    } else if (command == "calendar" && (field_count == 3 || field_count == 6)) {
+        std::ostringstream calendar;
+        unsigned int resource_id = 0;
+        unsigned int page = 0;
+        
+        if (field_count == 6 && fields[3] != "all" && !parseUnsigned(fields[3], resource_id)) {
+            error = "Invalid resource ID";
+        } else if (field_count == 6 && fields[5] != "all" && !parseUnsigned(fields[5], page)) {
+            error = "Invalid page number";
+        } else if (writeCalendar(std::string(fields[1]), std::string(fields[2]), resource_id,
+                                 field_count == 6 ? std::string(fields[4]) : "text", page, calendar, error)) {
+            std::string lines = calendar.str();
+            output << "OK " << std::count(lines.begin(), lines.end(), '\n') << '\n' << lines;
+            return true;
+        }
+    } else if ((command == "import-resources" || command == "import-events") && field_count == 2) {
+        ImportReport report;
+        bool imported = (command == "import-resources")
+            ? resource_manager.importFromCsv(std::string(fields[1]), report, error)
+            : event_manager.importFromCsv(std::string(fields[1]), report, error);
+        if (imported) {
+            output << "OK " << report.imported << ' ' << report.rejected.size() << '\n';
+            for (unsigned int i = 0; i < report.rejected.size(); i++) {
+                output << report.rejected[i].first << '|' << report.rejected[i].second << '\n';
+            }
+            return true;
+        }
+    } else if (command == "archive" && field_count == 2) {
+        unsigned int archived_count;
+        if (event_manager.archiveEvents(std::string(fields[1]), archived_count, error)) {
+            output << "OK " << archived_count << '\n';
+            return true;
+        }
+    } else if (command == "status" && field_count == 1) {
+        output << "OK " << resource_manager.getResourceCount() << " resources, "
+               << event_manager.getEventCount() << " events\n";
+        return true;
+    } else if (command == "save" && field_count == 1) {
+        if (saveAllData(false, error)) {
+            output << "OK saved\n";
+            return true;
+        }
+    } else {
+        error = "Unknown command or wrong number of fields: " + std::string(command);
+    }
+    
+    output << "ERROR " << error << '\n';
+    return false;
+}
+
+bool CampusSystem::saveAllData(bool changed_only, std::string& error) {
+    bool resources_saved = true;
+    if (!changed_only || resource_manager.hasUnsavedChanges()) {
+        resources_saved = resource_manager.save(error);
+    }
+    
+    std::string event_error;
+    bool events_saved = true;
+    if (!changed_only || event_manager.hasUnsavedChanges()) {
+        events_saved = event_manager.save(event_error);
+    }
+    
+    if (resources_saved && !events_saved) {
+        error = event_error;
+    }
+    return resources_saved && events_saved;
 }
 
 void CampusSystem::loadAllData() {
-    resource_manager.loadFromFile();
-    event_manager.loadFromFile();
+    std::thread resource_loader([this]() {
+        resource_manager.load();
+    });
+    
+    event_manager.load();
+    resource_loader.join();
+    
+    if (resource_manager.getDamagedRecordCount() > 0) {
+        std::cerr << "Warning: " << resource_manager.getDamagedRecordCount() << " damaged resource record(s) were skipped and copied to "
+                  << resource_manager.getQuarantineFile() << std::endl;
+    }
+    if (event_manager.getDamagedRecordCount() > 0) {
+        std::cerr << "Warning: " << event_manager.getDamagedRecordCount() << " damaged event record(s) were skipped and copied to "
+                  << event_manager.getQuarantineFile() << std::endl;
+    }
+    if (event_manager.isArchiveDamaged()) {
+        std::cerr << "Warning: " << event_manager.getArchiveFile() << " is damaged, so archived events are not loaded. "
+                  << "The file was kept and noted in " << event_manager.getQuarantineFile() << std::endl;
+    }
+}
+
+void CampusSystem::removeStoresExcept(StorageFormat kept) const {
+    static const char* const SQLITE_SIDE_FILES[] = {"-journal", "-wal"};
+    
+    for (unsigned int i = 0; i < STORAGE_FORMAT_COUNT; i++) {
+        StorageFormat format = STORAGE_LOAD_ORDER[i];
+        if (format == kept) {
+            continue;
+        }
+        std::remove(resource_manager.getStorePath(format).c_str());
+        std::remove(event_manager.getStorePath(format).c_str());
+        if (format != SQLITE_STORAGE) {
+            continue;
+        }
+        for (unsigned int j = 0; j < sizeof(SQLITE_SIDE_FILES) / sizeof(SQLITE_SIDE_FILES[0]); j++) {
+            std::remove((resource_manager.getStorePath(format) + SQLITE_SIDE_FILES[j]).c_str());
+            std::remove((event_manager.getStorePath(format) + SQLITE_SIDE_FILES[j]).c_str());
+        }
+    }
+}
+
+bool CampusSystem::convertStorage(const std::string& format) {
+    StorageFormat target;
+    if (format == "binary") {
+        target = BINARY_STORAGE;
+    } else if (format == "text") {
+        target = TEXT_STORAGE;
+    } else if (format == "paged") {
+        target = PAGED_STORAGE;
+    } else if (format == "sqlite") {
+        target = SQLITE_STORAGE;
+    } else {
+        std::cout << "Error: Unknown storage format '" << format << "'. Use 'binary', 'text', 'paged' or 'sqlite'." << std::endl;
+        return false;
+    }
+    
+    std::string error;
+    if (!resource_manager.saveAs(target, error) || !event_manager.saveAs(target, error)) {
+        std::cout << "Error: Could not write " << format << " stores. " << error << std::endl;
+        return false;
+    }
+    removeStoresExcept(target);
+    
+    std::cout << "Converted " << resource_manager.getResourceCount() << " resource(s) and "
+              << event_manager.getEventCount() << " event(s) to " << format << " format." << std::endl;
+    return true;
+}
+
+bool CampusSystem::writeReport(const std::string& from_date, const std::string& to_date, const std::string& format,
+                               const std::string& day_start, const std::string& day_end, std::ostream& output,
+                               std::string& error) const {
+    if (format != "text" && format != "csv" && format != "json") {
+        error = "Unknown report format '" + format + "'. Use 'text', 'csv' or 'json'.";
+        return false;
+    }
+    
+    UtilizationReport report;
+    if (!event_manager.buildUtilizationReport(from_date, to_date, day_start, day_end, report, error)) {
+        return false;
+    }
+    
+    if (format == "csv") {
+        report.writeCsv(output);
+    } else if (format == "json") {
+        report.writeJson(output);
+    } else {
+        report.print(output);
+    }
+    return true;
+}
+
+bool CampusSystem::collectCalendar(const std::string& view, const std::string& date, unsigned int resource_id,
+                                   std::string& heading, std::vector<Event>& occurrences, std::string& error) const {
+    if (view != "day" && view != "week") {
+        error = "Unknown calendar view '" + view + "'. Use 'day' or 'week'.";
+        return false;
+    }
+    if (!isValidDate(date)) {
+        error = "Invalid date format! Please use YYYY-MM-DD.";
+        return false;
+    }
+    
+    long first_day = stampToDay(toMinuteStamp(date, "00:00"));
+    long last_day = first_day;
+    if (view == "week") {
+        first_day -= weekdayOfDay(first_day);
+        last_day = first_day + 6;
+    }
+    std::string from_date = stampToDate(first_day * 1440);
+    std::string to_date = stampToDate(last_day * 1440);
+    
+    bool listed = resource_id == 0
+        ? event_manager.listOccurrences(from_date, to_date, occurrences, error)
+        : event_manager.listResourceOccurrences(resource_id, from_date, to_date, occurrences, error);
+    if (!listed) {
+        return false;
+    }
+    
+    heading = view == "day" ? "Day calendar: " + from_date : "Week calendar: " + from_date + " to " + to_date;
+    if (resource_id != 0) {
+        Resource resource;
+        if (resource_manager.lookupResource(resource_id, resource)) {
+            heading += " - " + resource.getName() + " (#" + std::to_string(resource_id) + ")";
+        }
+    }
+    return true;
+}
+
+bool CampusSystem::writeCalendar(const std::string& view, const std::string& date, unsigned int resource_id,
+                                 const std::string& format, unsigned int page, std::ostream& output,
+                                 std::string& error) const {
+    if (format != "text" && format != "jsonl") {
+        error = "Unknown calendar format '" + format + "'. Use 'text' or 'jsonl'.";
+        return false;
+    }
+    
+    std::string heading;
+    std::vector<Event> occurrences;
+    if (!collectCalendar(view, date, resource_id, heading, occurrences, error)) {
+        return false;
+    }
+    
+    CalendarView calendar(resource_manager, format == "jsonl", CalendarView::DEFAULT_PAGE_SIZE);
+    return calendar.write(heading, occurrences, page, output, error);
+}
+
+void CampusSystem::showCalendar(const std::string& view, const std::string& date, unsigned int resource_id) {
+    std::string heading, error;
+    std::vector<Event> occurrences;
+    if (!collectCalendar(view, date, resource_id, heading, occurrences, error)) {
+        std::cout << "Error: " << error << std::endl;
+        return;
+    }
+    
+    CalendarView calendar(resource_manager, false, CalendarView::DEFAULT_PAGE_SIZE);
+    unsigned int page_count = calendar.getPageCount(occurrences.size());
+    for (unsigned int page = 1; page <= page_count; page++) {
+        std::cout << std::endl;
+        calendar.write(heading, occurrences, page, std::cout, error);
+        if (page < page_count) {
+            std::string input;
+            std::cout << "\nPress Enter for the next page, or 'q' to stop: " << std::flush;
+            std::getline(std::cin, input);
+            if (input == "q" || input == "Q") {
+                break;
+            }
+        }
+    }
+    std::cout << std::flush;
+}
+
+bool CampusSystem::importCsv(const std::string& kind, const std::string& path) {
+    ImportReport report;
+    std::string error;
+    bool imported;
+    
+    if (kind == "resources") {
+        imported = resource_manager.importFromCsv(path, report, error);
+    } else if (kind == "events") {
+        imported = event_manager.importFromCsv(path, report, error);
+    } else {
+        std::cout << "Error: Unknown import kind '" << kind << "'. Use 'resources' or 'events'." << std::endl;
+        return false;
+    }
+    
+    if (!imported) {
+        std::cout << "Error: " << error << std::endl;
+        return false;
+    }
+    
+    report.print(std::cout);
+    return true;
+}
+
+bool CampusSystem::archiveEvents(const std::string& before_date) {
+    unsigned int archived_count;
+    std::string error;
+    if (!event_manager.archiveEvents(before_date, archived_count, error)) {
+        std::cout << "Error: " << error << std::endl;
+        return false;
+    }
+    
+    std::cout << "Archived " << archived_count << " event(s) that ended before " << before_date << " to "
+              << event_manager.getArchiveFile() << "." << std::endl;
+    return true;
 }
 
 void CampusSystem::displaySystemStatus() const {
@@ -753,8 +1433,24 @@ void CampusSystem::displaySystemStatus() const {
     std::cout << "==================================================" << std::endl;
     std::cout << "Total Resources: " << resource_manager.getResourceCount() << std::endl;
     std::cout << "Total Events: " << event_manager.getEventCount() << std::endl;
+    if (event_manager.getArchivedCount() > 0) {
+        std::cout << "Archived Events: " << event_manager.getArchivedCount() << std::endl;
+    }
     std::cout << "System Status: Running" << std::endl;
     std::cout << "Data File: " << (resource_manager.getResourceCount() > 0 ? "Has Data" : "Empty") << std::endl;
+    
+    long today = std::time(NULL) / 60 / 1440;
+    long monday = today - weekdayOfDay(today);
+    UtilizationReport report;
+    std::string error;
+    if (resource_manager.getResourceCount() > 0 &&
+        event_manager.buildUtilizationReport(stampToDate(monday * 1440), stampToDate((monday + 6) * 1440),
+                                             "", "", report, error)) {
+        double capacity = 7.0 * 1440 * report.getResources().size();
+        std::cout << "Utilization This Week: " << std::fixed << std::setprecision(1)
+                  << report.getBookedMinutes() * 100.0 / capacity << "% booked, "
+                  << report.getIdleCount() << " idle resource(s)" << std::defaultfloat << std::endl;
+    }
     std::cout << "==================================================" << std::endl;
 }
 
@@ -763,6 +1459,19 @@ bool CampusSystem::isRunning() const {
 }
 
 CampusSystem::~CampusSystem(){
+    {
+        std::lock_guard<std::mutex> lock(flush_mutex);
+        stop_flushing = true;
+    }
+    flush_wakeup.notify_all();
+    flush_thread.join();
+    std::string error;
+    if (!saveAllData(true, error)) {
+        std::cerr << "Error: " << error << std::endl;
+    }
+    if (!is_interactive) {
+        return;
+    }
     std::cout << "\nExiting Campus Management System..." << std::endl;
     std::cout << "Thank you for using our system!" << std::endl;
     sleepSeconds(1.5);
@@ -0,0 +1,77 @@
+#include "CsvImport.hpp"
+
+ImportReport::ImportReport() {
+    imported = 0;
+}
+
+void ImportReport::reject(unsigned int line_number, const std::string& reason) {
+    rejected.push_back(std::make_pair(line_number, reason));
+}
+
+void ImportReport::print(std::ostream& output) const {
+    output << "Imported " << imported << " row(s), rejected " << rejected.size() << " row(s)." << '\n';
+    for (unsigned int i = 0; i < rejected.size(); i++) {
+        output << "  line " << rejected[i].first << ": " << rejected[i].second << '\n';
+    }
+}
+
+bool parseCsvLine(std::string_view line, std::vector<std::string>& fields) {
+    fields.clear();
+    if (!line.empty() && line[line.size() - 1] == '\r') {
+        line.remove_suffix(1);
+    }
+    
+    std::string field;
+    bool in_quotes = false;
+    
+    for (std::string_view::size_type i = 0; i < line.size(); i++) {
+        char c = line[i];
+        
+        if (in_quotes) {
+            if (c == '"' && i + 1 < line.size() && line[i + 1] == '"') {
+                field += '"';
+                i++;
+            } else if (c == '"') {
+                in_quotes = false;
+            } else {
+                field += c;
+            }
+        } else if (c == '"') {
+            in_quotes = true;
+        } else if (c == ',') {
+            fields.push_back(field);
+            field.clear();
+        } else {
+            field += c;
+        }
+    }
+    
+    fields.push_back(field);
+    return !in_quotes;
+}
+
+bool parseCsvBool(const std::string& text, bool& value) {
+    if (text == "1" || text == "y" || text == "Y" || text == "yes" || text == "true") {
+        value = true;
+        return true;
+    }
+    if (text == "0" || text == "n" || text == "N" || text == "no" || text == "false") {
+        value = false;
+        return true;
+    }
+    return false;
+}
+
+bool isCsvHeader(const std::vector<std::string>& fields, const char* first_column) {
+    if (fields.empty()) {
+        return false;
+    }
+    
+    std::string first = fields[0];
+    for (unsigned int i = 0; i < first.length(); i++) {
+        if (first[i] >= 'A' && first[i] <= 'Z') {
+            first[i] = first[i] + 32;
+        }
+    }
+    return first == first_column;
+}
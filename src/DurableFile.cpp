@@ -0,0 +1,225 @@
+#include "DurableFile.hpp"
+#include "outils.hpp"
+#include <atomic>
+#include <mutex>
+#include <fstream>
+#include <filesystem>
+#include <cstdlib>
+#ifndef _WIN32
+    #include <fcntl.h>
+    #include <unistd.h>
+#endif
+
+static const std::size_t CHECKSUM_SUFFIX_SIZE = 10;
+static const char* const HEX_DIGITS = "0123456789abcdef";
+
+struct CrcTables {
+    uint32_t entries[8][256];
+
+    CrcTables() {
+        for (uint32_t i = 0; i < 256; i++) {
+            uint32_t crc = i;
+            for (int bit = 0; bit < 8; bit++) {
+                crc = (crc & 1) ? (crc >> 1) ^ 0xEDB88320u : crc >> 1;
+            }
+            entries[0][i] = crc;
+        }
+        for (int table = 1; table < 8; table++) {
+            for (uint32_t i = 0; i < 256; i++) {
+                uint32_t previous = entries[table - 1][i];
+                entries[table][i] = (previous >> 8) ^ entries[0][previous & 0xFF];
+            }
+        }
+    }
+};
+
+static const CrcTables CRC_TABLES;
+static std::atomic<long> fault_countdown(-1);
+static std::once_flag fault_setting_loaded;
+
+static void loadFaultSetting() {
+    const char* setting = std::getenv(FAULT_INJECTION_VARIABLE);
+    unsigned int writes;
+    if (setting != NULL && parseUnsigned(setting, writes)) {
+        fault_countdown = writes;
+    }
+}
+
+static bool reachedFault() {
+    std::call_once(fault_setting_loaded, loadFaultSetting);
+    return fault_countdown.load() >= 0 && fault_countdown.fetch_sub(1) == 0;
+}
+
+static uint32_t loadWord(const unsigned char* bytes) {
+    return static_cast<uint32_t>(bytes[0]) | static_cast<uint32_t>(bytes[1]) << 8 |
+           static_cast<uint32_t>(bytes[2]) << 16 | static_cast<uint32_t>(bytes[3]) << 24;
+}
+
+uint32_t crc32(std::string_view data) {
+    const uint32_t (*table)[256] = CRC_TABLES.entries;
+    const unsigned char* bytes = reinterpret_cast<const unsigned char*>(data.data());
+    std::size_t remaining = data.size();
+    uint32_t crc = 0xFFFFFFFFu;
+
+    while (remaining >= 8) {
+        uint32_t low = crc ^ loadWord(bytes);
+        uint32_t high = loadWord(bytes + 4);
+        crc = table[7][low & 0xFF] ^ table[6][(low >> 8) & 0xFF] ^ table[5][(low >> 16) & 0xFF] ^
+              table[4][low >> 24] ^ table[3][high & 0xFF] ^ table[2][(high >> 8) & 0xFF] ^
+              table[1][(high >> 16) & 0xFF] ^ table[0][high >> 24];
+        bytes += 8;
+        remaining -= 8;
+    }
+    while (remaining > 0) {
+        crc = table[0][(crc ^ *bytes) & 0xFF] ^ (crc >> 8);
+        bytes++;
+        remaining--;
+    }
+    return crc ^ 0xFFFFFFFFu;
+}
+
+void appendChecksum(std::string& line) {
+    uint32_t crc = crc32(line);
+    line += "|#";
+    for (int shift = 28; shift >= 0; shift -= 4) {
+        line += HEX_DIGITS[(crc >> shift) & 0xF];
+    }
+}
+
+ChecksumState stripChecksum(std::string_view& line) {
+    if (line.size() < CHECKSUM_SUFFIX_SIZE || line[line.size() - 10] != '|' || line[line.size() - 9] != '#') {
+        return CHECKSUM_MISSING;
+    }
+
+    uint32_t stored = 0;
+    for (std::size_t i = line.size() - 8; i < line.size(); i++) {
+        char c = line[i];
+        if (c >= '0' && c <= '9') {
+            stored = (stored << 4) | static_cast<uint32_t>(c - '0');
+        } else if (c >= 'a' && c <= 'f') {
+            stored = (stored << 4) | static_cast<uint32_t>(c - 'a' + 10);
+        } else {
+            return CHECKSUM_MISSING;
+        }
+    }
+
+    line.remove_suffix(CHECKSUM_SUFFIX_SIZE);
+    return crc32(line) == stored ? CHECKSUM_VALID : CHECKSUM_INVALID;
+}
+
+bool writeBytes(std::FILE* file, std::string_view data) {
+    if (reachedFault()) {
+        std::fwrite(data.data(), 1, data.size() / 2, file);
+        std::fflush(file);
+        std::_Exit(FAULT_EXIT_CODE);
+    }
+    return std::fwrite(data.data(), 1, data.size(), file) == data.size();
+}
+
+bool syncFile(std::FILE* file) {
+    if (std::fflush(file) != 0) {
+        return false;
+    }
+    #ifndef _WIN32
+        return fsync(fileno(file)) == 0;
+    #else
+        return true;
+    #endif
+}
+
+bool syncDirectoryOf(const std::string& path) {
+    #ifndef _WIN32
+        std::string directory = std::filesystem::path(path).parent_path().string();
+        int fd = ::open(directory.empty() ? "." : directory.c_str(), O_RDONLY);
+        if (fd < 0) {
+            return false;
+        }
+        bool synced = fsync(fd) == 0;
+        close(fd);
+        return synced;
+    #else
+        (void)path;
+        return true;
+    #endif
+}
+
+void crashIfFaultReached() {
+    if (reachedFault()) {
+        std::_Exit(FAULT_EXIT_CODE);
+    }
+}
+
+void armFaultInjection(long writes) {
+    std::call_once(fault_setting_loaded, loadFaultSetting);
+    fault_countdown = writes;
+}
+
+void quarantineRecord(const std::string& quarantine_file, const std::string& origin, std::string_view raw) {
+    std::ofstream file(quarantine_file, std::ios::out | std::ios::app | std::ios::binary);
+    if (!file.is_open()) {
+        return;
+    }
+
+    std::string line = origin + '|';
+    for (unsigned int i = 0; i < raw.size(); i++) {
+        unsigned char c = static_cast<unsigned char>(raw[i]);
+        line += (c < 0x20 || c == 0x7F) ? '?' : raw[i];
+    }
+    file << line << '\n';
+}
+
+AtomicFile::AtomicFile(const std::string& path) {
+    this->path = path;
+    temp_path = path + ".tmp";
+    file = NULL;
+}
+
+AtomicFile::~AtomicFile() {
+    abort();
+}
+
+bool AtomicFile::open() {
+    abort();
+    file = std::fopen(temp_path.c_str(), "wb");
+    return file != NULL;
+}
+
+bool AtomicFile::write(std::string_view data) {
+    if (file == NULL) {
+        return false;
+    }
+    if (!writeBytes(file, data)) {
+        abort();
+        return false;
+    }
+    return true;
+}
+
+bool AtomicFile::commit() {
+    if (file == NULL) {
+        return false;
+    }
+
+    bool synced = syncFile(file);
+    bool closed = std::fclose(file) == 0;
+    file = NULL;
+    if (!synced || !closed) {
+        std::remove(temp_path.c_str());
+        return false;
+    }
+
+    crashIfFaultReached();
+    if (std::rename(temp_path.c_str(), path.c_str()) != 0) {
+        std::remove(temp_path.c_str());
+        return false;
+    }
+    return syncDirectoryOf(path);
+}
+
+void AtomicFile::abort() {
+    if (file != NULL) {
+        std::fclose(file);
+        file = NULL;
+        std::remove(temp_path.c_str());
+    }
+}
@@ -1,71 +1,122 @@
 #include "Event.hpp"
-#include <sstream>
-#include <iomanip>
+#include "outils.hpp"
 
 Event::Event() {
     id = 0;
     title = "Default Event";
-    date = "2025-01-01";
-    start_time = "00:00";
+    start_stamp = toMinuteStamp("2025-01-01", "00:00");
     duration_minutes = 60;
     resource_ids.clear();
 }
 
 Event::Event(unsigned int id, const std::string& title, const std::string& date,
              const std::string& start_time, int duration_minutes, 
-             const std::vector<unsigned int>& resource_ids) {
+             const ResourceIdList& resource_ids) {
     this->id = id;
     this->title = title;
-    this->date = date;
-    this->start_time = start_time;
+    this->start_stamp = toMinuteStamp(date, start_time);
     this->duration_minutes = duration_minutes;
     this->resource_ids = resource_ids;
 }
 
-Event::~Event() {
+Event::Event(unsigned int id, const std::string& title, long start_stamp,
+             int duration_minutes, const ResourceIdList& resource_ids) {
+    this->id = id;
+    this->title = title;
+    this->start_stamp = start_stamp;
+    this->duration_minutes = duration_minutes;
+    this->resource_ids = resource_ids;
 }
 
 unsigned int Event::getId() const {
     return id;
 }
 
-std::string Event::getTitle() const {
+const std::string& Event::getTitle() const {
     return title;
 }
 
 std::string Event::getDate() const {
-    return date;
+    return stampToDate(start_stamp);
 }
 
 std::string Event::getStartTime() const {
-    return start_time;
+    return stampToTime(start_stamp);
+}
+
+long Event::getStartStamp() const {
+    return start_stamp;
+}
+
+long Event::getEndStamp() const {
+    return start_stamp + duration_minutes;
 }
 
 int Event::getDurationMinutes() const {
     return duration_minutes;
 }
 
-std::vector<unsigned int> Event::getResourceIds() const {
+const ResourceIdList& Event::getResourceIds() const {
     return resource_ids;
 }
 
+const Recurrence& Event::getRecurrence() const {
+    return recurrence;
+}
+
+bool Event::isRecurring() const {
+    return recurrence.isRecurring();
+}
+
+long Event::getLastEndStamp() const {
+    if (!recurrence.isRecurring()) {
+        return getEndStamp();
+    }
+    return start_stamp + (recurrence.getLastDay() - stampToDay(start_stamp)) * 1440 + duration_minutes;
+}
+
+bool Event::overlapsOccurrence(long start, long end) const {
+    if (!recurrence.isRecurring()) {
+        return start_stamp < end && getEndStamp() > start;
+    }
+    
+    long time_of_day = start_stamp - stampToDay(start_stamp) * 1440;
+    long first_day = stampToDay(start - time_of_day - duration_minutes) + 1;
+    long last_day = stampToDay(end - time_of_day - 1);
+    return recurrence.nextOn(first_day) <= last_day;
+}
+
+void Event::collectOccurrences(long from, long to, std::vector<long>& starts) const {
+    long time_of_day = start_stamp - stampToDay(start_stamp) * 1440;
+    long first_day = stampToDay(from - time_of_day - duration_minutes) + 1;
+    long last_day = stampToDay(to - time_of_day - 1);
+    
+    for (long day = recurrence.nextOn(first_day); day <= last_day; day = recurrence.nextOn(day + 1)) {
+        starts.push_back(day * 1440 + time_of_day);
+    }
+}
+
 void Event::setTitle(const std::string& title) {
     this->title = title;
 }
 
 void Event::setDate(const std::string& date) {
-    this->date = date;
+    this->start_stamp = toMinuteStamp(date, getStartTime());
 }
 
 void Event::setStartTime(const std::string& start_time) {
-    this->start_time = start_time;
+    this->start_stamp = toMinuteStamp(getDate(), start_time);
+}
+
+void Event::setStartStamp(long start_stamp) {
+    this->start_stamp = start_stamp;
 }
 
 void Event::setDurationMinutes(int duration_minutes) {
     this->duration_minutes = duration_minutes;
 }
 
-void Event::setResourceIds(const std::vector<unsigned int>& resource_ids) {
+void Event::setResourceIds(const ResourceIdList& resource_ids) {
     this->resource_ids = resource_ids;
 }
 
@@ -80,18 +131,46 @@ void Event::addResourceId(unsigned int resource_id) {
 void Event::removeResourceId(unsigned int resource_id) {
     for (unsigned int i = 0; i < resource_ids.size(); i++) {
         if (resource_ids[i] == resource_id) {
-            resource_ids.erase(resource_ids.begin() + i);
+            resource_ids.erase(i);
             return;
         }
     }
 }
 
+void Event::replaceResourceId(unsigned int old_id, unsigned int new_id) {
+    ResourceIdList replaced;
+    for (unsigned int i = 0; i < resource_ids.size(); i++) {
+        if (resource_ids[i] != old_id) {
+            replaced.push_back(resource_ids[i]);
+        } else if (!resource_ids.contains(new_id) && !replaced.contains(new_id)) {
+            replaced.push_back(new_id);
+        }
+    }
+    resource_ids = replaced;
+}
+
+bool Event::setRecurrence(const Recurrence& recurrence, std::string& error) {
+    Recurrence anchored = recurrence;
+    if (!anchored.anchor(stampToDay(start_stamp), error)) {
+        return false;
+    }
+    this->recurrence = anchored;
+    return true;
+}
+
+bool Event::skipOccurrence(long day) {
+    return recurrence.isRecurring() && recurrence.addException(day);
+}
+
 void Event::displayInfo() const {
     std::cout << "=================================================" << std::endl;
     std::cout << "Event ID: " << id << std::endl;
     std::cout << "Title: " << title << std::endl;
-    std::cout << "Date: " << date << std::endl;
-    std::cout << "Time: " << start_time << " - " << getEndTime() << std::endl;
+    std::cout << "Date: " << getDate() << std::endl;
+    if (recurrence.isRecurring()) {
+        std::cout << "Repeats: " << recurrence.describe() << std::endl;
+    }
+    std::cout << "Time: " << getStartTime() << " - " << getEndTime() << std::endl;
     std::cout << "Duration: " << duration_minutes << " minutes" << std::endl;
     std::cout << "Resource IDs: ";
     if (resource_ids.empty()) {
@@ -117,23 +196,11 @@ std::string Event::toString() const {
         }
     }
     
-    return std::to_string(id) + "|" + title + "|" + date + "|" + 
-           start_time + "|" + std::to_string(duration_minutes) + "|" + 
-           resource_ids_str;
+    return std::to_string(id) + "|" + title + "|" + getDate() + "|" + 
+           getStartTime() + "|" + std::to_string(duration_minutes) + "|" + 
+           resource_ids_str + (recurrence.isRecurring() ? "|" + recurrence.toString() : "");
 }
 
 std::string Event::getEndTime() const {
-    int hours = std::stoi(start_time.substr(0, 2));
-    int minutes = std::stoi(start_time.substr(3, 2));
-    
-    minutes += duration_minutes;
-    hours += minutes / 60;
-    minutes = minutes % 60;
-    hours = hours % 24;
-    
-    std::stringstream ss;
-    ss << std::setfill('0') << std::setw(2) << hours << ":" 
-       << std::setfill('0') << std::setw(2) << minutes;
-    
-    return ss.str();
+    return stampToTime(getEndStamp());
 }
\ No newline at end of file
@@ -0,0 +1,360 @@
+#include "EventArchive.hpp"
+#include "BinarySnapshot.hpp"
+#include "DurableFile.hpp"
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+
+static const char ARCHIVE_MAGIC[4] = {'C', 'R', 'M', 'A'};
+
+static bool archivedBefore(const Event& a, const Event& b) {
+    if (a.getStartStamp() != b.getStartStamp()) {
+        return a.getStartStamp() < b.getStartStamp();
+    }
+    return a.getId() < b.getId();
+}
+
+EventArchive::EventArchive(const std::string& path, RecordParser parse) : path(path), parse(parse) {
+    valid_length = 0;
+    entry_count = 0;
+    max_id = 0;
+    horizon = 0;
+    damaged = false;
+    torn = false;
+    cache_capacity = DEFAULT_CACHE_CAPACITY;
+}
+
+bool EventArchive::open() {
+    close();
+    if (!file.open(path)) {
+        std::error_code error;
+        damaged = std::filesystem::exists(path, error);
+        return false;
+    }
+
+    std::string_view view = file.view();
+    uint64_t end = view.size();
+    bool valid = readSegments(view, end, segments);
+    while (!valid && end > FOOTER_SIZE) {
+        end--;
+        valid = std::memcmp(view.data() + end - FOOTER_SIZE, ARCHIVE_MAGIC, 4) == 0 &&
+                readSegments(view, end, segments);
+    }
+    if (!valid) {
+        segments.clear();
+        file.close();
+        damaged = true;
+        return false;
+    }
+
+    valid_length = end;
+    torn = end < view.size();
+    for (unsigned int i = 0; i < segments.size(); i++) {
+        entry_count += segments[i].entry_count;
+        max_id = std::max(max_id, segments[i].max_id);
+        horizon = std::max(horizon, segments[i].horizon);
+    }
+    return true;
+}
+
+void EventArchive::close() {
+    clearCache();
+    file.close();
+    segments.clear();
+    valid_length = 0;
+    entry_count = 0;
+    max_id = 0;
+    horizon = 0;
+    damaged = false;
+    torn = false;
+}
+
+bool EventArchive::readSegments(std::string_view view, uint64_t end, std::vector<Segment>& found) const {
+    found.clear();
+    while (end > 0) {
+        if (end < FOOTER_SIZE) {
+            return false;
+        }
+
+        const char* footer = view.data() + end - FOOTER_SIZE;
+        if (std::memcmp(footer, ARCHIVE_MAGIC, 4) != 0 || readU32(footer + 4) != VERSION ||
+            readU32(footer + FOOTER_SIZE - 4) != crc32(std::string_view(footer, FOOTER_SIZE - 4))) {
+            return false;
+        }
+
+        uint32_t count = readU32(footer + 8);
+        uint64_t index_offset = static_cast<uint64_t>(readI64(footer + 32));
+        uint64_t table_size = static_cast<uint64_t>(count) * (ENTRY_SIZE + ID_ENTRY_SIZE);
+        uint64_t body_size = end - FOOTER_SIZE;
+        if (table_size > body_size || index_offset > body_size - table_size) {
+            return false;
+        }
+
+        uint64_t start = body_size - table_size - index_offset;
+        Segment segment;
+        segment.content = view.substr(start, index_offset);
+        segment.entries = view.data() + start + index_offset;
+        segment.id_table = segment.entries + static_cast<std::size_t>(count) * ENTRY_SIZE;
+        segment.entry_count = count;
+        segment.max_id = readU32(footer + 12);
+        segment.longest_span = readI64(footer + 16);
+        segment.horizon = readI64(footer + 24);
+        found.push_back(segment);
+        end = start;
+    }
+
+    std::reverse(found.begin(), found.end());
+    return true;
+}
+
+bool EventArchive::append(std::vector<Event>& archived) {
+    std::sort(archived.begin(), archived.end(), archivedBefore);
+
+    std::string output;
+    std::vector<std::pair<unsigned int, uint32_t> > ids;
+    std::string index;
+    ids.reserve(archived.size());
+    index.reserve(archived.size() * ENTRY_SIZE);
+    uint32_t highest_id = 0;
+    long widest = 0;
+    long latest_end = 0;
+
+    for (unsigned int i = 0; i < archived.size(); i++) {
+        const Event& event = archived[i];
+        std::string record = event.toString();
+        appendChecksum(record);
+        long last_end = event.getLastEndStamp();
+
+        putU32(index, event.getId());
+        putU32(index, record.size());
+        putI64(index, event.getStartStamp());
+        putI64(index, last_end);
+        putI64(index, static_cast<int64_t>(output.size()));
+        output += record;
+        output += '\n';
+
+        ids.push_back(std::make_pair(event.getId(), i));
+        highest_id = std::max<uint32_t>(highest_id, event.getId());
+        widest = std::max(widest, last_end - event.getStartStamp());
+        latest_end = std::max(latest_end, last_end);
+    }
+
+    std::sort(ids.begin(), ids.end());
+    uint64_t index_offset = output.size();
+    output += index;
+    for (unsigned int i = 0; i < ids.size(); i++) {
+        putU32(output, ids[i].first);
+        putU32(output, ids[i].second);
+    }
+
+    std::string footer(ARCHIVE_MAGIC, 4);
+    putU32(footer, VERSION);
+    putU32(footer, archived.size());
+    putU32(footer, highest_id);
+    putI64(footer, widest);
+    putI64(footer, latest_end);
+    putI64(footer, static_cast<int64_t>(index_offset));
+    putU32(footer, 0);
+    putU32(footer, crc32(footer));
+    output += footer;
+
+    uint64_t kept_length = valid_length;
+    close();
+    if (kept_length == 0) {
+        bool written = writeFileAtomically(path, output);
+        return open() && written;
+    }
+
+    std::error_code error;
+    std::filesystem::resize_file(path, kept_length, error);
+    std::FILE* stream = error ? NULL : std::fopen(path.c_str(), "ab");
+    bool written = stream != NULL && writeBytes(stream, output) && syncFile(stream);
+    if (stream != NULL && std::fclose(stream) != 0) {
+        written = false;
+    }
+    if (!written) {
+        std::filesystem::resize_file(path, kept_length, error);
+    }
+    return open() && written;
+}
+
+bool EventArchive::findEntry(const Segment& segment, unsigned int id, uint32_t& entry) const {
+    uint32_t low = 0;
+    uint32_t high = segment.entry_count;
+    while (low < high) {
+        uint32_t middle = low + (high - low) / 2;
+        if (readU32(segment.id_table + static_cast<std::size_t>(middle) * ID_ENTRY_SIZE) < id) {
+            low = middle + 1;
+        } else {
+            high = middle;
+        }
+    }
+
+    if (low == segment.entry_count || readU32(segment.id_table + static_cast<std::size_t>(low) * ID_ENTRY_SIZE) != id) {
+        return false;
+    }
+    entry = readU32(segment.id_table + static_cast<std::size_t>(low) * ID_ENTRY_SIZE + 4);
+    return entry < segment.entry_count;
+}
+
+bool EventArchive::findNewest(unsigned int id, uint32_t& segment, uint32_t& entry) const {
+    for (segment = segments.size(); segment > 0; segment--) {
+        if (findEntry(segments[segment - 1], id, entry)) {
+            segment--;
+            return true;
+        }
+    }
+    return false;
+}
+
+bool EventArchive::isShadowed(uint32_t segment, unsigned int id) const {
+    uint32_t entry;
+    for (uint32_t newer = segment + 1; newer < segments.size(); newer++) {
+        if (findEntry(segments[newer], id, entry)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+uint32_t EventArchive::firstEntryFrom(const Segment& segment, long start) const {
+    uint32_t low = 0;
+    uint32_t high = segment.entry_count;
+    while (low < high) {
+        uint32_t middle = low + (high - low) / 2;
+        if (readI64(segment.entries + static_cast<std::size_t>(middle) * ENTRY_SIZE + 8) < start) {
+            low = middle + 1;
+        } else {
+            high = middle;
+        }
+    }
+    return low;
+}
+
+bool EventArchive::readEntry(uint32_t segment, uint32_t entry, Event& event) const {
+    uint64_t key = (static_cast<uint64_t>(segment) << 32) | entry;
+    std::lock_guard<std::mutex> lock(cache_mutex);
+    std::unordered_map<uint64_t, std::list<CachedEvent>::iterator>::iterator cached = cache_index.find(key);
+    if (cached != cache_index.end()) {
+        cache.splice(cache.begin(), cache, cached->second);
+        event = cached->second->event;
+        return true;
+    }
+
+    const Segment& source = segments[segment];
+    const char* fields = source.entries + static_cast<std::size_t>(entry) * ENTRY_SIZE;
+    uint64_t offset = static_cast<uint64_t>(readI64(fields + 24));
+    uint32_t length = readU32(fields + 4);
+    if (offset > source.content.size() || length > source.content.size() - offset) {
+        return false;
+    }
+
+    std::string_view record = source.content.substr(offset, length);
+    if (stripChecksum(record) != CHECKSUM_VALID || !parse(record, event)) {
+        return false;
+    }
+
+    if (cache_capacity == 0) {
+        return true;
+    }
+    cache.push_front(CachedEvent{key, event});
+    cache_index[key] = cache.begin();
+    if (cache.size() > cache_capacity) {
+        cache_index.erase(cache.back().key);
+        cache.pop_back();
+    }
+    return true;
+}
+
+void EventArchive::clearCache() {
+    std::lock_guard<std::mutex> lock(cache_mutex);
+    cache.clear();
+    cache_index.clear();
+}
+
+bool EventArchive::find(unsigned int id, Event& event) const {
+    uint32_t segment;
+    uint32_t entry;
+    return findNewest(id, segment, entry) && readEntry(segment, entry, event);
+}
+
+bool EventArchive::contains(unsigned int id) const {
+    uint32_t segment;
+    uint32_t entry;
+    return findNewest(id, segment, entry);
+}
+
+void EventArchive::collectRange(long range_start, long range_end, std::vector<Event>& found) const {
+    Event event;
+    for (uint32_t s = 0; s < segments.size(); s++) {
+        const Segment& segment = segments[s];
+        if (range_start >= segment.horizon) {
+            continue;
+        }
+
+        for (uint32_t i = firstEntryFrom(segment, range_start - segment.longest_span); i < segment.entry_count; i++) {
+            const char* fields = segment.entries + static_cast<std::size_t>(i) * ENTRY_SIZE;
+            if (readI64(fields + 8) >= range_end) {
+                break;
+            }
+            if (readI64(fields + 16) > range_start && !isShadowed(s, readU32(fields)) && readEntry(s, i, event)) {
+                found.push_back(event);
+            }
+        }
+    }
+}
+
+void EventArchive::collectAll(std::vector<Event>& all) const {
+    all.reserve(all.size() + entry_count);
+    Event event;
+    for (uint32_t s = 0; s < segments.size(); s++) {
+        for (uint32_t i = 0; i < segments[s].entry_count; i++) {
+            const char* fields = segments[s].entries + static_cast<std::size_t>(i) * ENTRY_SIZE;
+            if (!isShadowed(s, readU32(fields)) && readEntry(s, i, event)) {
+                all.push_back(event);
+            }
+        }
+    }
+}
+
+void EventArchive::setCacheCapacity(std::size_t capacity) {
+    std::lock_guard<std::mutex> lock(cache_mutex);
+    cache_capacity = capacity;
+    while (cache.size() > cache_capacity) {
+        cache_index.erase(cache.back().key);
+        cache.pop_back();
+    }
+}
+
+std::size_t EventArchive::getCachedCount() const {
+    std::lock_guard<std::mutex> lock(cache_mutex);
+    return cache.size();
+}
+
+unsigned int EventArchive::size() const {
+    return entry_count;
+}
+
+unsigned int EventArchive::getSegmentCount() const {
+    return segments.size();
+}
+
+unsigned int EventArchive::getMaxId() const {
+    return max_id;
+}
+
+long EventArchive::getHorizon() const {
+    return horizon;
+}
+
+std::string EventArchive::getPath() const {
+    return path;
+}
+
+bool EventArchive::isDamaged() const {
+    return damaged;
+}
+
+bool EventArchive::hasTornTail() const {
+    return torn;
+}
@@ -0,0 +1,190 @@
+#include "EventCodec.hpp"
+#include "BinarySnapshot.hpp"
+#include "outils.hpp"
+#include <algorithm>
+
+static const char EVENT_SNAPSHOT_MAGIC[4] = {'C', 'R', 'M', 'E'};
+static const uint32_t EVENT_SNAPSHOT_VERSION = 2;
+static const std::size_t EVENT_RECORD_SIZE_V1 = 28;
+static const std::size_t EVENT_RECORD_SIZE = 32;
+
+EventCodec::EventCodec() {
+    table.name = "events";
+    table.columns.push_back(SqliteColumn{"title", "TEXT NOT NULL", true});
+    table.columns.push_back(SqliteColumn{"start_stamp", "INTEGER NOT NULL", true});
+    table.columns.push_back(SqliteColumn{"duration", "INTEGER NOT NULL", false});
+    table.columns.push_back(SqliteColumn{"recurrence", "TEXT", false});
+    table.link_table = "event_resources";
+    table.link_owner = "event_id";
+    table.link_column = "resource_id";
+}
+
+std::string EventCodec::toLine(const Event& event) const {
+    return event.toString();
+}
+
+bool EventCodec::parseLine(std::string_view line, Event& event) const {
+    std::string_view parts[7];
+    unsigned int part_count = splitFields(line, '|', parts, 7);
+    if (part_count != 6 && part_count != 7) {
+        return false;
+    }
+    
+    unsigned int id;
+    int duration;
+    if (!parseUnsigned(parts[0], id) || !parseInt(parts[4], duration)) {
+        return false;
+    }
+    
+    std::vector<unsigned int> resource_ids;
+    resource_ids.reserve(std::count(parts[5].begin(), parts[5].end(), ',') + 1);
+    std::string_view::size_type id_start = 0;
+    
+    while (id_start < parts[5].size()) {
+        std::string_view::size_type id_end = parts[5].find(',', id_start);
+        if (id_end == std::string_view::npos) {
+            id_end = parts[5].size();
+        }
+        
+        unsigned int resource_id;
+        if (parseUnsigned(parts[5].substr(id_start, id_end - id_start), resource_id)) {
+            resource_ids.push_back(resource_id);
+        }
+        id_start = id_end + 1;
+    }
+    
+    event = Event(id, std::string(parts[1]), toMinuteStamp(parts[2], parts[3]), duration, resource_ids);
+    if (part_count == 7) {
+        Recurrence recurrence;
+        std::string error;
+        return recurrence.parse(parts[6], error) && event.setRecurrence(recurrence, error);
+    }
+    return true;
+}
+
+void EventCodec::writeSnapshot(const std::vector<const Event*>& events, std::string& content) const {
+    StringTableBuilder strings;
+    std::string records;
+    std::string resource_ids;
+    records.reserve(events.size() * EVENT_RECORD_SIZE);
+    uint32_t id_count = 0;
+    
+    for (unsigned int i = 0; i < events.size(); i++) {
+        const Event& event = *events[i];
+        const ResourceIdList& event_resources = event.getResourceIds();
+        
+        putU32(records, event.getId());
+        putU32(records, strings.intern(event.getTitle()));
+        putI64(records, event.getStartStamp());
+        putI32(records, event.getDurationMinutes());
+        putU32(records, id_count);
+        putU32(records, event_resources.size());
+        putU32(records, event.isRecurring() ? strings.intern(event.getRecurrence().toString()) + 1 : 0);
+        
+        for (unsigned int j = 0; j < event_resources.size(); j++) {
+            putU32(resource_ids, event_resources[j]);
+        }
+        id_count += event_resources.size();
+    }
+    
+    SnapshotHeader header;
+    std::copy(EVENT_SNAPSHOT_MAGIC, EVENT_SNAPSHOT_MAGIC + 4, header.magic);
+    header.version = EVENT_SNAPSHOT_VERSION;
+    header.record_count = events.size();
+    header.id_count = id_count;
+    header.string_count = strings.getCount();
+    header.string_bytes = strings.getByteSize();
+    
+    content.clear();
+    content.reserve(SNAPSHOT_HEADER_SIZE + records.size() + resource_ids.size() +
+                    (header.string_count + 1) * 4 + header.string_bytes);
+    writeSnapshotHeader(content, header);
+    content += records;
+    content += resource_ids;
+    strings.appendTo(content);
+}
+
+bool EventCodec::readSnapshot(std::string_view content, std::vector<Event>& events) const {
+    SnapshotHeader header;
+    if (!readSnapshotHeader(content, EVENT_SNAPSHOT_MAGIC, EVENT_SNAPSHOT_VERSION, header)) {
+        return false;
+    }
+    
+    std::size_t record_size = header.version == 1 ? EVENT_RECORD_SIZE_V1 : EVENT_RECORD_SIZE;
+    std::size_t records_size = static_cast<std::size_t>(header.record_count) * record_size;
+    std::size_t ids_size = static_cast<std::size_t>(header.id_count) * 4;
+    if (content.size() < SNAPSHOT_HEADER_SIZE + records_size + ids_size) {
+        return false;
+    }
+    
+    StringTableView strings;
+    if (!strings.attach(content.substr(SNAPSHOT_HEADER_SIZE + records_size + ids_size),
+                        header.string_count, header.string_bytes)) {
+        return false;
+    }
+    
+    events.reserve(header.record_count);
+    const char* record = content.data() + SNAPSHOT_HEADER_SIZE;
+    const char* ids = record + records_size;
+    
+    for (unsigned int i = 0; i < header.record_count; i++, record += record_size) {
+        std::string_view title;
+        uint32_t id_offset = readU32(record + 20);
+        uint32_t id_total = readU32(record + 24);
+        
+        if (!strings.get(readU32(record + 4), title) ||
+            id_offset > header.id_count || id_total > header.id_count - id_offset) {
+            return false;
+        }
+        
+        std::vector<unsigned int> resource_ids(id_total);
+        for (unsigned int j = 0; j < id_total; j++) {
+            resource_ids[j] = readU32(ids + (id_offset + j) * 4);
+        }
+        
+        events.push_back(Event(readU32(record), std::string(title), readI64(record + 8), readI32(record + 16),
+                               resource_ids));
+        
+        uint32_t rule_index = record_size == EVENT_RECORD_SIZE ? readU32(record + 28) : 0;
+        if (rule_index != 0) {
+            std::string_view rule;
+            Recurrence recurrence;
+            std::string error;
+            if (!strings.get(rule_index - 1, rule) || !recurrence.parse(rule, error) ||
+                !events.back().setRecurrence(recurrence, error)) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+const SqliteTable& EventCodec::getSqliteTable() const {
+    return table;
+}
+
+void EventCodec::writeRow(const Event& event, SqliteRow& row) const {
+    row.setId(event.getId());
+    row.setText(0, event.getTitle());
+    row.setInteger(1, event.getStartStamp());
+    row.setInteger(2, event.getDurationMinutes());
+    if (event.isRecurring()) {
+        row.setText(3, event.getRecurrence().toString());
+    } else {
+        row.setNull(3);
+    }
+    
+    const ResourceIdList& resource_ids = event.getResourceIds();
+    row.getLinks().assign(resource_ids.begin(), resource_ids.end());
+}
+
+bool EventCodec::readRow(const SqliteRow& row, Event& event) const {
+    event = Event(row.getId(), std::string(row.getText(0)), static_cast<long>(row.getInteger(1)),
+                  static_cast<int>(row.getInteger(2)), row.getLinks());
+    if (!row.isNull(3)) {
+        Recurrence recurrence;
+        std::string error;
+        return recurrence.parse(row.getText(3), error) && event.setRecurrence(recurrence, error);
+    }
+    return true;
+}
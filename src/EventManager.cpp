@@ -1,82 +1,707 @@
 #include "EventManager.hpp"
+#include "DurableFile.hpp"
+#include "outils.hpp"
+#include "MappedFile.hpp"
+#include "CsvImport.hpp"
+#include <cstdio>
+#include <algorithm>
+#include <thread>
+#include <numeric>
 
-EventManager::EventManager(ResourceManager* res_manager) {
+static const unsigned int MIN_JOURNAL_ENTRIES_BEFORE_COMPACTION = 1024;
+static const char EVENT_PAGES_MAGIC[4] = {'C', 'R', 'P', 'E'};
+static const int MINUTES_PER_DAY = 1440;
+static const unsigned int MAX_SUGGESTIONS = 5;
+
+EventManager::EventManager(ResourceManager* res_manager)
+    : journal("data/events.log"),
+      text_store("data/events.txt", codec),
+      binary_store("data/events.bin", codec),
+      paged_store("data/events.pages", EVENT_PAGES_MAGIC, codec),
+      sqlite_store("data/events.db", codec),
+      archive("data/events.archive", [this](std::string_view line, Event& event) {
+          return codec.parseLine(line, event);
+      }) {
     resource_manager = res_manager;
-    data_file = "data/events.txt";
+    stores[TEXT_STORAGE] = &text_store;
+    stores[BINARY_STORAGE] = &binary_store;
+    stores[PAGED_STORAGE] = &paged_store;
+    stores[SQLITE_STORAGE] = &sqlite_store;
+    backend = &text_store;
+    quarantine_file = "data/events.quarantine";
+    auto_save = true;
     next_id = 1;
+    damaged_count = 0;
+    longest_duration = 0;
 }
 
 EventManager::~EventManager() {
 }
 
-std::string EventManager::calculateEndTime(const std::string& start_time, int duration_minutes) const {
-    int hours = std::stoi(start_time.substr(0, 2));
-    int minutes = std::stoi(start_time.substr(3, 2));
+std::string EventManager::calculateEndTime(long start_stamp, int duration_minutes) const {
+    return stampToTime(start_stamp + duration_minutes);
+}
+
+bool EventManager::timesOverlap(long start1, long end1, long start2, long end2) const {
+    return (start1 < end2) && (end1 > start2);
+}
+
+static bool startsBefore(const Event& a, const Event& b) {
+    if (a.getStartStamp() != b.getStartStamp()) {
+        return a.getStartStamp() < b.getStartStamp();
+    }
+    return a.getId() < b.getId();
+}
+
+static bool sharesResource(const ResourceIdList& booked, const ResourceIdList& wanted) {
+    for (unsigned int i = 0; i < wanted.size(); i++) {
+        if (booked.contains(wanted[i])) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void EventManager::indexEvent(const Event& event) {
+    if (event.isRecurring()) {
+        const ResourceIdList& event_resources = event.getResourceIds();
+        for (unsigned int i = 0; i < event_resources.size(); i++) {
+            resource_series[event_resources[i]].push_back(event.getId());
+        }
+        series_ids.push_back(event.getId());
+        return;
+    }
     
-    minutes += duration_minutes;
-    hours += minutes / 60;
-    minutes = minutes % 60;
-    hours = hours % 24;
+    long start = event.getStartStamp();
+    BookedSlot slot;
+    slot.end = event.getEndStamp();
+    slot.event_id = event.getId();
     
-    std::stringstream ss;
-    ss << (hours < 10 ? "0" : "") << hours << ":" 
-       << (minutes < 10 ? "0" : "") << minutes;
+    DayBooking booking = {start, event.getId()};
+    std::vector<DayBooking>& day = day_bookings[stampToDay(start)];
+    day.insert(std::upper_bound(day.begin(), day.end(), booking, [](const DayBooking& a, const DayBooking& b) {
+        return a.start != b.start ? a.start < b.start : a.event_id < b.event_id;
+    }), booking);
     
-    return ss.str();
+    const ResourceIdList& event_resources = event.getResourceIds();
+    for (unsigned int i = 0; i < event_resources.size(); i++) {
+        resource_schedule[event_resources[i]].insert(std::make_pair(start, slot));
+    }
+    
+    if (event.getDurationMinutes() > longest_duration) {
+        longest_duration = event.getDurationMinutes();
+    }
 }
 
-bool EventManager::timesOverlap(const std::string& start1, const std::string& end1,
-                                const std::string& start2, const std::string& end2) const {
-    return (start1 < end2) && (end1 > start2);
+void EventManager::unindexEvent(const Event& event) {
+    if (event.isRecurring()) {
+        const ResourceIdList& event_resources = event.getResourceIds();
+        for (unsigned int i = 0; i < event_resources.size(); i++) {
+            std::unordered_map<unsigned int, std::vector<unsigned int> >::iterator series =
+                resource_series.find(event_resources[i]);
+            if (series == resource_series.end()) {
+                continue;
+            }
+            
+            std::vector<unsigned int>& ids = series->second;
+            ids.erase(std::remove(ids.begin(), ids.end(), event.getId()), ids.end());
+            if (ids.empty()) {
+                resource_series.erase(series);
+            }
+        }
+        series_ids.erase(std::remove(series_ids.begin(), series_ids.end(), event.getId()), series_ids.end());
+        return;
+    }
+    
+    long start = event.getStartStamp();
+    
+    std::map<long, std::vector<DayBooking> >::iterator day = day_bookings.find(stampToDay(start));
+    if (day != day_bookings.end()) {
+        std::vector<DayBooking>& bookings = day->second;
+        for (unsigned int i = 0; i < bookings.size(); i++) {
+            if (bookings[i].event_id == event.getId() && bookings[i].start == start) {
+                bookings.erase(bookings.begin() + i);
+                break;
+            }
+        }
+        if (bookings.empty()) {
+            day_bookings.erase(day);
+        }
+    }
+    
+    const ResourceIdList& event_resources = event.getResourceIds();
+    for (unsigned int i = 0; i < event_resources.size(); i++) {
+        std::unordered_map<unsigned int, std::multimap<long, BookedSlot> >::iterator schedule =
+            resource_schedule.find(event_resources[i]);
+        if (schedule == resource_schedule.end()) {
+            continue;
+        }
+        
+        std::multimap<long, BookedSlot>& slots = schedule->second;
+        std::multimap<long, BookedSlot>::iterator it = slots.lower_bound(start);
+        while (it != slots.end() && it->first == start) {
+            if (it->second.event_id == event.getId()) {
+                slots.erase(it);
+                break;
+            }
+            ++it;
+        }
+        
+        if (slots.empty()) {
+            resource_schedule.erase(schedule);
+        }
+    }
 }
 
-bool EventManager::hasConflict(const std::vector<unsigned int>& resource_ids, const std::string& date, 
-                               const std::string& start_time, int duration_minutes,
-                               unsigned int exclude_event_id) const {
-    std::string end_time = calculateEndTime(start_time, duration_minutes);
+void EventManager::rebuildSchedule() {
+    resource_schedule.clear();
+    resource_series.clear();
+    day_bookings.clear();
+    series_ids.clear();
+    longest_duration = 0;
+    for (SlabStore<Event>::const_iterator it = events.begin(); it != events.end(); ++it) {
+        indexEvent(*it);
+    }
+}
+
+bool EventManager::hasConflict(const std::vector<unsigned int>& resource_ids, long start_stamp,
+                               int duration_minutes, unsigned int exclude_event_id) const {
+    std::shared_lock<std::shared_mutex> lock(mutex);
+    return conflictsWith(resource_ids, start_stamp, duration_minutes, exclude_event_id);
+}
+
+bool EventManager::conflictsWith(const ResourceIdList& resource_ids, long start_stamp,
+                                 int duration_minutes, unsigned int exclude_event_id) const {
+    long end = start_stamp + duration_minutes;
     
     for (unsigned int r = 0; r < resource_ids.size(); r++) {
-        unsigned int resource_id = resource_ids[r];
+        std::unordered_map<unsigned int, std::multimap<long, BookedSlot> >::const_iterator schedule =
+            resource_schedule.find(resource_ids[r]);
+        if (schedule != resource_schedule.end()) {
+            const std::multimap<long, BookedSlot>& slots = schedule->second;
+            std::multimap<long, BookedSlot>::const_iterator it = slots.lower_bound(start_stamp - longest_duration);
+            
+            for (; it != slots.end() && it->first < end; ++it) {
+                if (it->second.event_id != exclude_event_id &&
+                    timesOverlap(start_stamp, end, it->first, it->second.end)) {
+                    return true;
+                }
+            }
+        }
         
-        for (unsigned int i = 0; i < events.size(); i++) {
-            if (events[i].getId() == exclude_event_id) {
-                continue;
+        std::unordered_map<unsigned int, std::vector<unsigned int> >::const_iterator series =
+            resource_series.find(resource_ids[r]);
+        if (series != resource_series.end()) {
+            for (unsigned int i = 0; i < series->second.size(); i++) {
+                if (series->second[i] != exclude_event_id &&
+                    events[id_index.find(series->second[i])->second].overlapsOccurrence(start_stamp, end)) {
+                    return true;
+                }
             }
+        }
+    }
+    
+    if (start_stamp >= archive.getHorizon()) {
+        return false;
+    }
+    return archivedConflict(Event(0, "", start_stamp, duration_minutes, resource_ids), exclude_event_id);
+}
+
+bool EventManager::eventConflicts(const Event& candidate, unsigned int exclude_event_id) const {
+    const ResourceIdList& resource_ids = candidate.getResourceIds();
+    if (!candidate.isRecurring()) {
+        return conflictsWith(resource_ids, candidate.getStartStamp(), candidate.getDurationMinutes(), exclude_event_id);
+    }
+    
+    long last_end = candidate.getLastEndStamp();
+    
+    for (unsigned int r = 0; r < resource_ids.size(); r++) {
+        std::unordered_map<unsigned int, std::multimap<long, BookedSlot> >::const_iterator schedule =
+            resource_schedule.find(resource_ids[r]);
+        if (schedule != resource_schedule.end()) {
+            const std::multimap<long, BookedSlot>& slots = schedule->second;
+            std::multimap<long, BookedSlot>::const_iterator it =
+                slots.lower_bound(candidate.getStartStamp() - longest_duration);
             
-            std::vector<unsigned int> event_resources = events[i].getResourceIds();
-            bool uses_same_resource = false;
-            
-            for (unsigned int j = 0; j < event_resources.size(); j++) {
-                if (event_resources[j] == resource_id) {
-                    uses_same_resource = true;
-                    break;
+            for (; it != slots.end() && it->first < last_end; ++it) {
+                if (it->second.event_id != exclude_event_id &&
+                    candidate.overlapsOccurrence(it->first, it->second.end)) {
+                    return true;
                 }
             }
-            
-            if (uses_same_resource && events[i].getDate() == date) {
-                std::string existing_end = events[i].getEndTime();
-                
-                if (timesOverlap(start_time, end_time, 
-                               events[i].getStartTime(), existing_end)) {
+        }
+        
+        std::unordered_map<unsigned int, std::vector<unsigned int> >::const_iterator series =
+            resource_series.find(resource_ids[r]);
+        if (series != resource_series.end()) {
+            for (unsigned int i = 0; i < series->second.size(); i++) {
+                if (series->second[i] != exclude_event_id &&
+                    seriesOverlap(candidate, events[id_index.find(series->second[i])->second])) {
                     return true;
                 }
             }
         }
     }
     
+    return archivedConflict(candidate, exclude_event_id);
+}
+
+bool EventManager::archivedConflict(const Event& candidate, unsigned int exclude_event_id) const {
+    if (candidate.getStartStamp() >= archive.getHorizon()) {
+        return false;
+    }
+    
+    std::vector<Event> archived;
+    archive.collectRange(candidate.getStartStamp(), candidate.getLastEndStamp(), archived);
+    for (unsigned int i = 0; i < archived.size(); i++) {
+        const Event& other = archived[i];
+        if (other.getId() == exclude_event_id || id_index.find(other.getId()) != id_index.end() ||
+            !sharesResource(other.getResourceIds(), candidate.getResourceIds())) {
+            continue;
+        }
+        
+        bool overlaps;
+        if (!other.isRecurring()) {
+            overlaps = candidate.overlapsOccurrence(other.getStartStamp(), other.getEndStamp());
+        } else if (!candidate.isRecurring()) {
+            overlaps = other.overlapsOccurrence(candidate.getStartStamp(), candidate.getEndStamp());
+        } else {
+            overlaps = seriesOverlap(candidate, other);
+        }
+        if (overlaps) {
+            return true;
+        }
+    }
     return false;
 }
 
+bool EventManager::seriesOverlap(const Event& series, const Event& other) const {
+    const Recurrence& first = series.getRecurrence();
+    const Recurrence& second = other.getRecurrence();
+    long cycle_days = std::lcm(first.getPeriodDays(), second.getPeriodDays());
+    long from_day = std::max(first.getFirstDay(), second.getFirstDay()) - 1;
+    long to_day = std::min(first.getLastDay(), second.getLastDay()) + 1;
+    to_day = std::min(to_day, std::max(first.getSettledDay(), second.getSettledDay()) + cycle_days + 1);
+    if (to_day < from_day) {
+        return false;
+    }
+    
+    std::vector<long> starts;
+    series.collectOccurrences(from_day * MINUTES_PER_DAY, (to_day + 1) * MINUTES_PER_DAY, starts);
+    for (unsigned int i = 0; i < starts.size(); i++) {
+        if (other.overlapsOccurrence(starts[i], starts[i] + series.getDurationMinutes())) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void EventManager::collectBusyIntervals(const std::vector<unsigned int>& resource_ids, long range_start,
+                                        long range_end, std::vector<std::pair<long, long> >& busy) const {
+    busy.clear();
+    
+    for (unsigned int r = 0; r < resource_ids.size(); r++) {
+        std::vector<std::pair<long, long> >::size_type run_start = busy.size();
+        std::unordered_map<unsigned int, std::multimap<long, BookedSlot> >::const_iterator schedule =
+            resource_schedule.find(resource_ids[r]);
+        if (schedule != resource_schedule.end()) {
+            const std::multimap<long, BookedSlot>& slots = schedule->second;
+            std::multimap<long, BookedSlot>::const_iterator it = slots.lower_bound(range_start - longest_duration);
+            
+            for (; it != slots.end() && it->first < range_end; ++it) {
+                if (it->second.end > range_start) {
+                    busy.push_back(std::make_pair(it->first, it->second.end));
+                }
+            }
+        }
+        
+        std::vector<std::pair<long, long> >::size_type series_start = busy.size();
+        std::unordered_map<unsigned int, std::vector<unsigned int> >::const_iterator series =
+            resource_series.find(resource_ids[r]);
+        if (series != resource_series.end()) {
+            std::vector<long> starts;
+            for (unsigned int i = 0; i < series->second.size(); i++) {
+                const Event& event = events[id_index.find(series->second[i])->second];
+                starts.clear();
+                event.collectOccurrences(range_start, range_end, starts);
+                for (unsigned int j = 0; j < starts.size(); j++) {
+                    busy.push_back(std::make_pair(starts[j], starts[j] + event.getDurationMinutes()));
+                }
+            }
+            std::sort(busy.begin() + series_start, busy.end());
+            std::inplace_merge(busy.begin() + run_start, busy.begin() + series_start, busy.end());
+        }
+        
+        std::inplace_merge(busy.begin(), busy.begin() + run_start, busy.end());
+    }
+    
+    std::vector<Event> archived;
+    appendArchivedOccurrences(range_start, range_end, 0, archived);
+    std::vector<std::pair<long, long> >::size_type archived_start = busy.size();
+    ResourceIdList wanted(resource_ids);
+    for (unsigned int i = 0; i < archived.size(); i++) {
+        if (sharesResource(archived[i].getResourceIds(), wanted)) {
+            busy.push_back(std::make_pair(archived[i].getStartStamp(), archived[i].getEndStamp()));
+        }
+    }
+    std::sort(busy.begin() + archived_start, busy.end());
+    std::inplace_merge(busy.begin(), busy.begin() + archived_start, busy.end());
+}
+
+bool EventManager::findFreeSlots(const std::vector<unsigned int>& resource_ids, int duration_minutes,
+                                 const std::string& from_date, const std::string& to_date,
+                                 const std::string& day_start, const std::string& day_end,
+                                 unsigned int max_slots, std::vector<FreeSlot>& slots, std::string& error) const {
+    std::shared_lock<std::shared_mutex> lock(mutex);
+    slots.clear();
+    if (!checkResources(resource_ids, error)) {
+        return false;
+    }
+    if (duration_minutes <= 0 || duration_minutes > 1440) {
+        error = "Duration must be between 1 and 1440 minutes!";
+        return false;
+    }
+    if (!isValidDate(from_date) || !isValidDate(to_date)) {
+        error = "Invalid date format! Please use YYYY-MM-DD.";
+        return false;
+    }
+    if (day_start.empty() != day_end.empty()) {
+        error = "Working hours need both a start and an end time!";
+        return false;
+    }
+    
+    int work_start = 0;
+    int work_end = MINUTES_PER_DAY;
+    if (!day_start.empty()) {
+        if (!isValidTime(day_start) || !isValidTime(day_end)) {
+            error = "Invalid time format! Please use HH:MM.";
+            return false;
+        }
+        work_start = toMinuteStamp("1970-01-01", day_start);
+        work_end = toMinuteStamp("1970-01-01", day_end);
+        if (work_end == 0) {
+            work_end = MINUTES_PER_DAY;
+        }
+        if (work_end - work_start < duration_minutes) {
+            error = "Working hours are shorter than the requested duration!";
+            return false;
+        }
+    }
+    
+    long range_start = toMinuteStamp(from_date, "00:00");
+    long range_end = toMinuteStamp(to_date, "00:00") + MINUTES_PER_DAY;
+    if (range_end <= range_start) {
+        error = "End date must not be before start date!";
+        return false;
+    }
+    
+    std::vector<std::pair<long, long> > busy;
+    collectBusyIntervals(resource_ids, range_start, range_end, busy);
+    bool whole_day = (work_start == 0 && work_end == MINUTES_PER_DAY);
+    long cursor = range_start;
+    
+    for (unsigned int i = 0; i <= busy.size() && slots.size() < max_slots; i++) {
+        long gap_end = (i < busy.size()) ? std::min(busy[i].first, range_end) : range_end;
+        
+        if (gap_end - cursor >= duration_minutes) {
+            if (whole_day) {
+                slots.push_back(FreeSlot{cursor, gap_end});
+            } else {
+                for (long day = range_start + (cursor - range_start) / MINUTES_PER_DAY * MINUTES_PER_DAY;
+                     day < gap_end && slots.size() < max_slots; day += MINUTES_PER_DAY) {
+                    long window_start = std::max(cursor, day + work_start);
+                    long window_end = std::min(gap_end, day + work_end);
+                    if (window_end - window_start >= duration_minutes) {
+                        slots.push_back(FreeSlot{window_start, window_end});
+                    }
+                }
+            }
+        }
+        
+        if (i < busy.size() && busy[i].second > cursor) {
+            cursor = busy[i].second;
+        }
+    }
+    
+    return true;
+}
+
+void EventManager::showFreeSlots(const std::vector<unsigned int>& resource_ids, int duration_minutes,
+                                 const std::string& from_date, const std::string& to_date,
+                                 const std::string& day_start, const std::string& day_end,
+                                 unsigned int max_slots) const {
+    std::vector<FreeSlot> slots;
+    std::string error;
+    if (!findFreeSlots(resource_ids, duration_minutes, from_date, to_date, day_start, day_end,
+                       max_slots, slots, error)) {
+        std::cout << "Error: " << error << std::endl;
+        return;
+    }
+    
+    if (slots.empty()) {
+        std::cout << "No free window of " << duration_minutes << " minutes found in this date range." << std::endl;
+        return;
+    }
+    
+    std::cout << "\n=== FREE TIME SLOTS ===" << std::endl;
+    for (unsigned int i = 0; i < slots.size(); i++) {
+        std::cout << (i + 1) << ". " << stampToDate(slots[i].start) << " " << stampToTime(slots[i].start)
+                  << " - " << stampToDate(slots[i].end) << " " << stampToTime(slots[i].end) << std::endl;
+    }
+}
+
+bool EventManager::buildUtilizationReport(const std::string& from_date, const std::string& to_date,
+                                          const std::string& day_start, const std::string& day_end,
+                                          UtilizationReport& report, std::string& error) const {
+    if (!isValidDate(from_date) || !isValidDate(to_date)) {
+        error = "Invalid date format! Please use YYYY-MM-DD.";
+        return false;
+    }
+    if (day_start.empty() != day_end.empty()) {
+        error = "Working hours need both a start and an end time!";
+        return false;
+    }
+    
+    int work_start = 0;
+    int work_end = MINUTES_PER_DAY;
+    if (!day_start.empty()) {
+        if (!isValidTime(day_start) || !isValidTime(day_end)) {
+            error = "Invalid time format! Please use HH:MM.";
+            return false;
+        }
+        work_start = toMinuteStamp("1970-01-01", day_start);
+        work_end = toMinuteStamp("1970-01-01", day_end);
+        if (work_end == 0) {
+            work_end = MINUTES_PER_DAY;
+        }
+        if (work_end <= work_start) {
+            error = "Working hours must end after they start!";
+            return false;
+        }
+    }
+    
+    long first_day = stampToDay(toMinuteStamp(from_date, "00:00"));
+    long last_day = stampToDay(toMinuteStamp(to_date, "00:00"));
+    if (last_day < first_day) {
+        error = "End date must not be before start date!";
+        return false;
+    }
+    if (last_day - first_day + 1 > UtilizationReport::MAX_DAYS) {
+        error = "Reports can cover at most " + std::to_string(UtilizationReport::MAX_DAYS) + " days!";
+        return false;
+    }
+    unsigned int day_count = last_day - first_day + 1;
+    
+    std::shared_lock<std::shared_mutex> lock(mutex);
+    std::vector<Resource> campus_resources;
+    resource_manager->listResources(campus_resources);
+    if (campus_resources.size() * static_cast<std::size_t>(day_count) > UtilizationReport::MAX_DAY_CELLS) {
+        error = "Report range is too large for this many resources! Please use a shorter range.";
+        return false;
+    }
+    
+    long range_start = first_day * MINUTES_PER_DAY;
+    long range_end = (last_day + 1) * MINUTES_PER_DAY;
+    std::vector<long> starts;
+    std::vector<unsigned int> slots;
+    report.begin(campus_resources, first_day, day_count, work_start, work_end);
+    
+    collectSingles(range_start, range_end, slots);
+    for (unsigned int i = 0; i < slots.size(); i++) {
+        const Event& event = events[slots[i]];
+        report.addBooking(event.getResourceIds(), event.getStartStamp(), event.getEndStamp());
+    }
+    
+    for (unsigned int i = 0; i < series_ids.size(); i++) {
+        const Event& event = events[id_index.find(series_ids[i])->second];
+        starts.clear();
+        event.collectOccurrences(range_start, range_end, starts);
+        for (unsigned int j = 0; j < starts.size(); j++) {
+            report.addBooking(event.getResourceIds(), starts[j], starts[j] + event.getDurationMinutes());
+        }
+    }
+    
+    std::vector<Event> archived;
+    appendArchivedOccurrences(range_start, range_end, 0, archived);
+    for (unsigned int i = 0; i < archived.size(); i++) {
+        report.addBooking(archived[i].getResourceIds(), archived[i].getStartStamp(), archived[i].getEndStamp());
+    }
+    
+    report.finish();
+    return true;
+}
+
 bool EventManager::isResourceUsedByEvents(unsigned int resource_id) const {
-    for (unsigned int i = 0; i < events.size(); i++) {
-        std::vector<unsigned int> event_resources = events[i].getResourceIds();
-        for (unsigned int j = 0; j < event_resources.size(); j++) {
-            if (event_resources[j] == resource_id) {
-                return true;
+    std::shared_lock<std::shared_mutex> lock(mutex);
+    return usesResource(resource_id);
+}
+
+bool EventManager::modifyResourceGuarded(unsigned int resource_id, const std::string& new_name,
+                                         const std::string& new_type, int new_availability, std::string& error) {
+    std::unique_lock<std::shared_mutex> lock(mutex);
+    return resource_manager->modifyResource(resource_id, new_name, new_type, new_availability,
+                                            !usesResource(resource_id), error);
+}
+
+bool EventManager::removeResourceGuarded(unsigned int resource_id, bool force, std::string& error) {
+    std::unique_lock<std::shared_mutex> lock(mutex);
+    if (!resource_manager->resourceExists(resource_id)) {
+        error = "Resource with ID " + std::to_string(resource_id) + " not found.";
+        return false;
+    }
+    if (!force && usesResource(resource_id)) {
+        error = "Resource " + std::to_string(resource_id) + " is used by one or more events (add |force to delete anyway)";
+        return false;
+    }
+    
+    std::vector<unsigned int> affected;
+    collectBookings(resource_id, affected);
+    for (unsigned int i = 0; i < affected.size(); i++) {
+        unsigned int slot = id_index.find(affected[i])->second;
+        Event& event = events[slot];
+        ResourceIdList remaining;
+        for (unsigned int j = 0; j < event.getResourceIds().size(); j++) {
+            if (event.getResourceIds()[j] != resource_id) {
+                remaining.push_back(event.getResourceIds()[j]);
+            }
+        }
+        if (remaining.empty()) {
+            if (!dropEvent(slot, error)) {
+                return false;
             }
+            continue;
         }
+        
+        Event updated = event;
+        updated.setResourceIds(remaining);
+        if (!journalChange(Journal::PUT, updated.toString(), error)) {
+            return false;
+        }
+        unindexEvent(event);
+        event = updated;
+        indexEvent(event);
+        recordChange(event.getId());
+    }
+    
+    return resource_manager->removeResource(resource_id, error);
+}
+
+bool EventManager::reassignResourceGuarded(unsigned int resource_id, unsigned int replacement_id, std::string& error) {
+    std::unique_lock<std::shared_mutex> lock(mutex);
+    if (!resource_manager->resourceExists(resource_id)) {
+        error = "Resource with ID " + std::to_string(resource_id) + " not found.";
+        return false;
+    }
+    if (replacement_id == resource_id) {
+        error = "A resource cannot be reassigned to itself.";
+        return false;
+    }
+    if (!checkResources(std::vector<unsigned int>(1, replacement_id), error)) {
+        return false;
+    }
+    
+    std::vector<unsigned int> affected;
+    collectBookings(resource_id, affected);
+    for (unsigned int i = 0; i < affected.size(); i++) {
+        Event moved = events[id_index.find(affected[i])->second];
+        moved.replaceResourceId(resource_id, replacement_id);
+        if (eventConflicts(moved, moved.getId())) {
+            error = "Event " + std::to_string(moved.getId()) + " '" + moved.getTitle() +
+                    "' would conflict with a booking of resource " + std::to_string(replacement_id) + ".";
+            return false;
+        }
+    }
+    
+    for (unsigned int i = 0; i < affected.size(); i++) {
+        Event& event = events[id_index.find(affected[i])->second];
+        Event moved = event;
+        moved.replaceResourceId(resource_id, replacement_id);
+        if (!journalChange(Journal::PUT, moved.toString(), error)) {
+            return false;
+        }
+        unindexEvent(event);
+        event = moved;
+        indexEvent(event);
+        recordChange(event.getId());
+    }
+    
+    return resource_manager->removeResource(resource_id, error);
+}
+
+bool EventManager::usesResource(unsigned int resource_id) const {
+    return resource_schedule.find(resource_id) != resource_schedule.end() ||
+           resource_series.find(resource_id) != resource_series.end();
+}
+
+void EventManager::collectBookings(unsigned int resource_id, std::vector<unsigned int>& event_ids) const {
+    event_ids.clear();
+    std::unordered_map<unsigned int, std::multimap<long, BookedSlot> >::const_iterator schedule =
+        resource_schedule.find(resource_id);
+    if (schedule != resource_schedule.end()) {
+        event_ids.reserve(schedule->second.size());
+        for (std::multimap<long, BookedSlot>::const_iterator it = schedule->second.begin();
+             it != schedule->second.end(); ++it) {
+            event_ids.push_back(it->second.event_id);
+        }
+    }
+    
+    std::unordered_map<unsigned int, std::vector<unsigned int> >::const_iterator series =
+        resource_series.find(resource_id);
+    if (series != resource_series.end()) {
+        event_ids.insert(event_ids.end(), series->second.begin(), series->second.end());
+    }
+    
+    std::sort(event_ids.begin(), event_ids.end());
+    event_ids.erase(std::unique(event_ids.begin(), event_ids.end()), event_ids.end());
+}
+
+bool EventManager::listResourceBookings(unsigned int resource_id, std::vector<Event>& bookings,
+                                        std::string& error) const {
+    std::shared_lock<std::shared_mutex> lock(mutex);
+    if (!resource_manager->resourceExists(resource_id)) {
+        error = "Resource with ID " + std::to_string(resource_id) + " not found.";
+        return false;
+    }
+    
+    std::vector<unsigned int> event_ids;
+    collectBookings(resource_id, event_ids);
+    bookings.clear();
+    bookings.reserve(event_ids.size());
+    for (unsigned int i = 0; i < event_ids.size(); i++) {
+        bookings.push_back(events[id_index.find(event_ids[i])->second]);
+    }
+    
+    std::sort(bookings.begin(), bookings.end(), [](const Event& a, const Event& b) {
+        if (a.getStartStamp() != b.getStartStamp()) {
+            return a.getStartStamp() < b.getStartStamp();
+        }
+        return a.getId() < b.getId();
+    });
+    return true;
+}
+
+void EventManager::showResourceBookings(unsigned int resource_id) const {
+    std::vector<Event> bookings;
+    std::string error;
+    if (!listResourceBookings(resource_id, bookings, error)) {
+        std::cout << "Error: " << error << std::endl;
+        return;
+    }
+    
+    Resource resource;
+    resource_manager->lookupResource(resource_id, resource);
+    if (bookings.empty()) {
+        std::cout << "Resource '" << resource.getName() << "' has no bookings." << std::endl;
+        return;
+    }
+    
+    std::cout << "\n=== BOOKINGS FOR " << resource.getName() << " (ID: " << resource_id << ") ===" << std::endl;
+    std::cout << "Total Bookings: " << bookings.size() << std::endl;
+    std::cout << std::endl;
+    for (unsigned int i = 0; i < bookings.size(); i++) {
+        bookings[i].displayInfo();
+        std::cout << std::endl;
     }
-    return false;
 }
 
 std::vector<unsigned int> EventManager::selectMultipleResourcesInteractive() {
@@ -109,96 +734,643 @@ std::vector<unsigned int> EventManager::selectMultipleResourcesInteractive() {
         if (!search_term.empty()) {
             resource_manager->searchResourceByType(search_term);
         }
-    } else {
-        std::cout << "Invalid choice!" << std::endl;
-        return selected_resources;
+    } else {
+        std::cout << "Invalid choice!" << std::endl;
+        return selected_resources;
+    }
+    
+    std::cout << "\nEnter resource IDs separated by commas (e.g., 1,3,5): ";
+    std::string ids_str;
+    std::getline(std::cin, ids_str);
+    
+    std::stringstream ss(ids_str);
+    std::string id_str;
+    
+    while (std::getline(ss, id_str, ',')) {
+        while (!id_str.empty() && (id_str[0] == ' ' || id_str[0] == '\t')) {
+            id_str = id_str.substr(1);
+        }
+        while (!id_str.empty() && (id_str[id_str.length()-1] == ' ' || id_str[id_str.length()-1] == '\t')) {
+            id_str = id_str.substr(0, id_str.length()-1);
+        }
+        
+        if (!id_str.empty()) {
+            unsigned int id;
+            std::stringstream id_ss(id_str);
+            id_ss >> id;
+            
+            if (resource_manager->resourceExists(id)) {
+                selected_resources.push_back(id);
+            } else {
+                std::cout << "Warning: Resource ID " << id << " does not exist. Skipping." << std::endl;
+            }
+        }
+    }
+    
+    if (selected_resources.empty()) {
+        std::cout << "No valid resources selected!" << std::endl;
+    } else {
+        std::cout << "Selected " << selected_resources.size() << " resource(s)." << std::endl;
+    }
+    
+    return selected_resources;
+}
+
+bool EventManager::checkResources(const ResourceIdList& resource_ids, std::string& error) const {
+    if (resource_ids.empty()) {
+        error = "No resources selected!";
+        return false;
+    }
+    
+    Resource resource;
+    for (unsigned int i = 0; i < resource_ids.size(); i++) {
+        if (!resource_manager->lookupResource(resource_ids[i], resource)) {
+            error = "Resource with ID " + std::to_string(resource_ids[i]) + " does not exist!";
+            return false;
+        }
+        if (!resource.isAvailable()) {
+            error = "Resource '" + resource.getName() + "' is not available (under maintenance or out of service).";
+            return false;
+        }
+    }
+    return true;
+}
+
+bool EventManager::isValidTitle(const std::string& title) const {
+    return !title.empty() && title.find('|') == std::string::npos && title.find('\n') == std::string::npos;
+}
+
+unsigned int EventManager::createEvent(const std::string& title, const std::string& date,
+                                       const std::string& start_time, int duration_minutes,
+                                       const std::vector<unsigned int>& resource_ids, std::string& error) {
+    return createEvent(title, date, start_time, duration_minutes, resource_ids, "", error);
+}
+
+unsigned int EventManager::createEvent(const std::string& title, const std::string& date,
+                                       const std::string& start_time, int duration_minutes,
+                                       const std::vector<unsigned int>& resource_ids,
+                                       const std::string& recurrence_rule, std::string& error) {
+    std::unique_lock<std::shared_mutex> lock(mutex);
+    if (!isValidTitle(title)) {
+        error = "Event title cannot be empty or contain '|'!";
+        return 0;
+    }
+    if (!isValidDate(date)) {
+        error = "Invalid date format! Please use YYYY-MM-DD.";
+        return 0;
+    }
+    if (!isValidTime(start_time)) {
+        error = "Invalid time format! Please use HH:MM.";
+        return 0;
+    }
+    if (duration_minutes <= 0 || duration_minutes > 1440) {
+        error = "Duration must be between 1 and 1440 minutes!";
+        return 0;
+    }
+    if (!checkResources(resource_ids, error)) {
+        return 0;
+    }
+    
+    Recurrence recurrence;
+    if (!recurrence.parse(recurrence_rule, error)) {
+        return 0;
+    }
+    
+    Event event(next_id, title, toMinuteStamp(date, start_time), duration_minutes, resource_ids);
+    if (!event.setRecurrence(recurrence, error)) {
+        return 0;
+    }
+    
+    if (eventConflicts(event, 0)) {
+        error = "Time conflict detected! One or more resources are already booked at this time.";
+        return 0;
+    }
+    
+    if (!journalChange(Journal::PUT, event.toString(), error)) {
+        return 0;
+    }
+    
+    SlabHandle handle = events.insert(std::move(event));
+    indexEvent(events[handle.slot]);
+    indexLookups(handle.slot);
+    title_trigrams.add(next_id, title);
+    recordChange(next_id);
+    return next_id++;
+}
+
+bool EventManager::parseCsvResourceIds(const std::string& text, std::vector<unsigned int>& resource_ids) const {
+    resource_ids.clear();
+    std::string::size_type id_start = text.find_first_not_of(",; ");
+    
+    while (id_start != std::string::npos) {
+        std::string::size_type id_end = text.find_first_of(",; ", id_start);
+        if (id_end == std::string::npos) {
+            id_end = text.size();
+        }
+        
+        unsigned int id;
+        if (!parseUnsigned(std::string_view(text).substr(id_start, id_end - id_start), id)) {
+            return false;
+        }
+        resource_ids.push_back(id);
+        id_start = text.find_first_not_of(",; ", id_end);
+    }
+    return !resource_ids.empty();
+}
+
+bool EventManager::importFromCsv(const std::string& path, ImportReport& report, std::string& error) {
+    std::unique_lock<std::shared_mutex> lock(mutex);
+    MappedFile file;
+    if (!file.open(path)) {
+        error = "Cannot open " + path;
+        return false;
+    }
+    
+    std::vector<ImportRow> rows;
+    std::string_view content = file.view();
+    std::vector<std::string> fields;
+    std::string_view::size_type line_start = 0;
+    unsigned int line_number = 0;
+    
+    while (line_start < content.size()) {
+        std::string_view::size_type line_end = content.find('\n', line_start);
+        if (line_end == std::string_view::npos) {
+            line_end = content.size();
+        }
+        std::string_view line = content.substr(line_start, line_end - line_start);
+        line_start = line_end + 1;
+        line_number++;
+        
+        if (line.empty() || line == "\r") {
+            continue;
+        }
+        if (!parseCsvLine(line, fields)) {
+            report.reject(line_number, "Unterminated quoted field");
+            continue;
+        }
+        if (line_number == 1 && isCsvHeader(fields, "title")) {
+            continue;
+        }
+        if (fields.size() != 5) {
+            report.reject(line_number, "Expected title,date,start_time,duration,resource_ids");
+            continue;
+        }
+        
+        ImportRow row;
+        row.line_number = line_number;
+        row.title = fields[0];
+        
+        if (!isValidTitle(row.title)) {
+            report.reject(line_number, "Event title cannot be empty or contain '|'");
+            continue;
+        }
+        if (!isValidDate(fields[1])) {
+            report.reject(line_number, "Invalid date '" + fields[1] + "'");
+            continue;
+        }
+        if (!isValidTime(fields[2])) {
+            report.reject(line_number, "Invalid time '" + fields[2] + "'");
+            continue;
+        }
+        if (!parseInt(fields[3], row.duration_minutes) || row.duration_minutes <= 0 || row.duration_minutes > 1440) {
+            report.reject(line_number, "Duration must be between 1 and 1440 minutes");
+            continue;
+        }
+        if (!parseCsvResourceIds(fields[4], row.resource_ids)) {
+            report.reject(line_number, "Invalid resource ID list '" + fields[4] + "'");
+            continue;
+        }
+        if (!checkResources(row.resource_ids, error)) {
+            report.reject(line_number, error);
+            continue;
+        }
+        
+        row.start_stamp = toMinuteStamp(fields[1], fields[2]);
+        rows.push_back(row);
+    }
+    file.close();
+    error.clear();
+    
+    std::sort(rows.begin(), rows.end(), [](const ImportRow& a, const ImportRow& b) {
+        if (a.start_stamp != b.start_stamp) {
+            return a.start_stamp < b.start_stamp;
+        }
+        return a.line_number < b.line_number;
+    });
+    
+    std::unordered_map<unsigned int, const ImportRow*> last_accepted;
+    std::vector<const ImportRow*> accepted;
+    accepted.reserve(rows.size());
+    
+    for (unsigned int i = 0; i < rows.size(); i++) {
+        const ImportRow& row = rows[i];
+        const ImportRow* clash = NULL;
+        
+        for (unsigned int j = 0; j < row.resource_ids.size() && clash == NULL; j++) {
+            std::unordered_map<unsigned int, const ImportRow*>::const_iterator it = last_accepted.find(row.resource_ids[j]);
+            if (it != last_accepted.end() &&
+                it->second->start_stamp + it->second->duration_minutes > row.start_stamp) {
+                clash = it->second;
+            }
+        }
+        
+        if (clash != NULL) {
+            report.reject(row.line_number, "Conflicts with line " + std::to_string(clash->line_number));
+            continue;
+        }
+        if (conflictsWith(row.resource_ids, row.start_stamp, row.duration_minutes)) {
+            report.reject(row.line_number, "Conflicts with an existing event");
+            continue;
+        }
+        
+        for (unsigned int j = 0; j < row.resource_ids.size(); j++) {
+            last_accepted[row.resource_ids[j]] = &row;
+        }
+        accepted.push_back(&row);
+    }
+    
+    std::sort(accepted.begin(), accepted.end(), [](const ImportRow* a, const ImportRow* b) {
+        return a->line_number < b->line_number;
+    });
+    std::sort(report.rejected.begin(), report.rejected.end());
+    
+    std::vector<Event> imported;
+    std::vector<std::string> payloads;
+    imported.reserve(accepted.size());
+    payloads.reserve(accepted.size());
+    for (unsigned int i = 0; i < accepted.size(); i++) {
+        imported.push_back(Event(next_id + i, accepted[i]->title, accepted[i]->start_stamp,
+                                 accepted[i]->duration_minutes, accepted[i]->resource_ids));
+        payloads.push_back(imported.back().toString());
+    }
+    if (!imported.empty() && !journalChange(Journal::PUT, payloads, error)) {
+        return false;
+    }
+    
+    events.reserve(events.size() + imported.size());
+    for (unsigned int i = 0; i < imported.size(); i++) {
+        SlabHandle handle = events.insert(std::move(imported[i]));
+        const Event& event = events[handle.slot];
+        indexEvent(event);
+        indexLookups(handle.slot);
+        title_trigrams.add(event.getId(), event.getTitle());
+        markDirty(event.getId());
+    }
+    next_id += imported.size();
+    report.imported = imported.size();
+    compactLargeJournal();
+    return true;
+}
+
+bool EventManager::modifyEvent(unsigned int id, const std::string& new_title, const std::string& new_date,
+                               const std::string& new_start_time, int new_duration,
+                               const std::vector<unsigned int>& new_resource_ids, std::string& error) {
+    std::unique_lock<std::shared_mutex> lock(mutex);
+    std::unordered_map<unsigned int, unsigned int>::const_iterator it = id_index.find(id);
+    if (it == id_index.end()) {
+        error = archive.contains(id) ? "Event with ID " + std::to_string(id) + " is archived and cannot be changed."
+                                     : "Event with ID " + std::to_string(id) + " not found.";
+        return false;
+    }
+    unsigned int slot = it->second;
+    Event* event = &events[slot];
+    if (!new_title.empty() && !isValidTitle(new_title)) {
+        error = "Event title cannot contain '|'!";
+        return false;
+    }
+    if (!new_date.empty() && !isValidDate(new_date)) {
+        error = "Invalid date format!";
+        return false;
+    }
+    if (!new_start_time.empty() && !isValidTime(new_start_time)) {
+        error = "Invalid time format!";
+        return false;
+    }
+    if (new_duration < 0 || new_duration > 1440) {
+        error = "Duration must be between 1 and 1440 minutes!";
+        return false;
+    }
+    
+    ResourceIdList check_resources = new_resource_ids.empty() ? event->getResourceIds() : ResourceIdList(new_resource_ids);
+    if (!checkResources(check_resources, error)) {
+        return false;
+    }
+    
+    std::string check_date = new_date.empty() ? event->getDate() : new_date;
+    std::string check_time = new_start_time.empty() ? event->getStartTime() : new_start_time;
+    long check_stamp = toMinuteStamp(check_date, check_time);
+    int check_duration = new_duration == 0 ? event->getDurationMinutes() : new_duration;
+    
+    Event updated = *event;
+    updated.setStartStamp(check_stamp);
+    updated.setDurationMinutes(check_duration);
+    updated.setResourceIds(check_resources);
+    if (!updated.setRecurrence(event->getRecurrence(), error)) {
+        return false;
+    }
+    
+    if (eventConflicts(updated, event->getId())) {
+        error = "Update would cause a time conflict!";
+        return false;
+    }
+    
+    bool renamed = !new_title.empty() && new_title != event->getTitle();
+    if (renamed) {
+        updated.setTitle(new_title);
+    }
+    if (!journalChange(Journal::PUT, updated.toString(), error)) {
+        return false;
+    }
+    
+    unindexEvent(*event);
+    if (renamed) {
+        title_trigrams.remove(id, event->getTitle());
+        unindexLookups(slot);
+    }
+    *event = updated;
+    indexEvent(*event);
+    if (renamed) {
+        indexLookups(slot);
+        title_trigrams.add(id, new_title);
+    }
+    
+    recordChange(id);
+    return true;
+}
+
+bool EventManager::removeEvent(unsigned int id, std::string& error) {
+    std::unique_lock<std::shared_mutex> lock(mutex);
+    std::unordered_map<unsigned int, unsigned int>::const_iterator it = id_index.find(id);
+    if (it == id_index.end()) {
+        error = archive.contains(id) ? "Event with ID " + std::to_string(id) + " is archived and cannot be changed."
+                                     : "Event with ID " + std::to_string(id) + " not found.";
+        return false;
+    }
+    
+    return dropEvent(it->second, error);
+}
+
+void EventManager::discardEvent(unsigned int slot) {
+    unindexEvent(events[slot]);
+    title_trigrams.remove(events[slot].getId(), events[slot].getTitle());
+    unindexLookups(slot);
+    events.erase(slot);
+}
+
+bool EventManager::dropEvent(unsigned int slot, std::string& error) {
+    unsigned int id = events[slot].getId();
+    if (!journalChange(Journal::REMOVE, std::to_string(id), error)) {
+        return false;
+    }
+    discardEvent(slot);
+    recordChange(id);
+    return true;
+}
+
+bool EventManager::archiveEvents(const std::string& before_date, unsigned int& archived_count, std::string& error) {
+    archived_count = 0;
+    if (!isValidDate(before_date)) {
+        error = "Invalid date format! Please use YYYY-MM-DD.";
+        return false;
+    }
+    
+    long cutoff = toMinuteStamp(before_date, "00:00");
+    std::unique_lock<std::shared_mutex> lock(mutex);
+    if (archive.isDamaged()) {
+        error = "Archive file '" + archive.getPath() + "' is damaged. Restore it from a backup before archiving more events.";
+        return false;
+    }
+    std::vector<unsigned int> slots;
+    for (SlabStore<Event>::const_iterator it = events.begin(); it != events.end(); ++it) {
+        if (it->getLastEndStamp() <= cutoff) {
+            slots.push_back(it.getSlot());
+        }
+    }
+    if (slots.empty()) {
+        return true;
+    }
+    
+    std::vector<Event> archived;
+    archived.reserve(slots.size());
+    for (unsigned int i = 0; i < slots.size(); i++) {
+        archived.push_back(events[slots[i]]);
+    }
+    
+    if (!archive.append(archived)) {
+        error = "Cannot write archive file '" + archive.getPath() + "'.";
+        return false;
+    }
+    
+    for (unsigned int i = 0; i < slots.size(); i++) {
+        unsigned int id = events[slots[i]].getId();
+        discardEvent(slots[i]);
+        markDirty(id);
+    }
+    archived_count = slots.size();
+    return compactJournal(error);
+}
+
+bool EventManager::skipOccurrence(unsigned int id, const std::string& date, std::string& error) {
+    std::unique_lock<std::shared_mutex> lock(mutex);
+    Event* event = findEvent(id);
+    if (event == NULL) {
+        error = archive.contains(id) ? "Event with ID " + std::to_string(id) + " is archived and cannot be changed."
+                                     : "Event with ID " + std::to_string(id) + " not found.";
+        return false;
+    }
+    if (!event->isRecurring()) {
+        error = "Event " + std::to_string(id) + " does not repeat; delete it instead.";
+        return false;
+    }
+    if (!isValidDate(date)) {
+        error = "Invalid date format! Please use YYYY-MM-DD.";
+        return false;
+    }
+    Event updated = *event;
+    if (!updated.skipOccurrence(stampToDay(toMinuteStamp(date, "00:00")))) {
+        error = "Event " + std::to_string(id) + " has no occurrence on " + date + ".";
+        return false;
+    }
+    if (!journalChange(Journal::PUT, updated.toString(), error)) {
+        return false;
+    }
+    
+    *event = updated;
+    recordChange(id);
+    return true;
+}
+
+bool EventManager::parseDateRange(const std::string& from_date, const std::string& to_date,
+                                  long& range_start, long& range_end, std::string& error) const {
+    if (!isValidDate(from_date) || !isValidDate(to_date)) {
+        error = "Invalid date format! Please use YYYY-MM-DD.";
+        return false;
+    }
+    
+    range_start = toMinuteStamp(from_date, "00:00");
+    range_end = toMinuteStamp(to_date, "00:00") + MINUTES_PER_DAY;
+    if (range_end <= range_start) {
+        error = "End date must not be before start date!";
+        return false;
+    }
+    return true;
+}
+
+void EventManager::collectSingles(long range_start, long range_end, std::vector<unsigned int>& slots) const {
+    std::map<long, std::vector<DayBooking> >::const_iterator day =
+        day_bookings.lower_bound(stampToDay(range_start - longest_duration));
+    
+    for (; day != day_bookings.end() && day->first * MINUTES_PER_DAY < range_end; ++day) {
+        const std::vector<DayBooking>& bookings = day->second;
+        for (unsigned int i = 0; i < bookings.size() && bookings[i].start < range_end; i++) {
+            unsigned int slot = id_index.find(bookings[i].event_id)->second;
+            if (events[slot].getEndStamp() > range_start) {
+                slots.push_back(slot);
+            }
+        }
+    }
+}
+
+void EventManager::appendSeriesOccurrences(const std::vector<unsigned int>& ids, long range_start, long range_end,
+                                           std::vector<Event>& occurrences) const {
+    std::vector<Event>::size_type single_count = occurrences.size();
+    std::vector<long> starts;
+    
+    for (unsigned int i = 0; i < ids.size(); i++) {
+        const Event& series = events[id_index.find(ids[i])->second];
+        starts.clear();
+        series.collectOccurrences(range_start, range_end, starts);
+        for (unsigned int j = 0; j < starts.size(); j++) {
+            occurrences.push_back(Event(series.getId(), series.getTitle(), starts[j],
+                                        series.getDurationMinutes(), series.getResourceIds()));
+        }
     }
     
-    std::cout << "\nEnter resource IDs separated by commas (e.g., 1,3,5): ";
-    std::string ids_str;
-    std::getline(std::cin, ids_str);
+    std::sort(occurrences.begin() + single_count, occurrences.end(), startsBefore);
+    std::inplace_merge(occurrences.begin(), occurrences.begin() + single_count, occurrences.end(), startsBefore);
+}
+
+void EventManager::appendArchivedOccurrences(long range_start, long range_end, unsigned int resource_id,
+                                             std::vector<Event>& occurrences) const {
+    if (range_start >= archive.getHorizon()) {
+        return;
+    }
     
-    std::stringstream ss(ids_str);
-    std::string id_str;
+    std::vector<Event> archived;
+    archive.collectRange(range_start, range_end, archived);
+    std::vector<Event>::size_type live_count = occurrences.size();
+    std::vector<long> starts;
     
-    while (std::getline(ss, id_str, ',')) {
-        while (!id_str.empty() && (id_str[0] == ' ' || id_str[0] == '\t')) {
-            id_str = id_str.substr(1);
+    for (unsigned int i = 0; i < archived.size(); i++) {
+        const Event& event = archived[i];
+        if (id_index.find(event.getId()) != id_index.end() ||
+            (resource_id != 0 && !event.getResourceIds().contains(resource_id))) {
+            continue;
         }
-        while (!id_str.empty() && (id_str[id_str.length()-1] == ' ' || id_str[id_str.length()-1] == '\t')) {
-            id_str = id_str.substr(0, id_str.length()-1);
+        if (!event.isRecurring()) {
+            occurrences.push_back(event);
+            continue;
         }
         
-        if (!id_str.empty()) {
-            unsigned int id;
-            std::stringstream id_ss(id_str);
-            id_ss >> id;
-            
-            if (resource_manager->resourceExists(id)) {
-                selected_resources.push_back(id);
-            } else {
-                std::cout << "Warning: Resource ID " << id << " does not exist. Skipping." << std::endl;
-            }
+        starts.clear();
+        event.collectOccurrences(range_start, range_end, starts);
+        for (unsigned int j = 0; j < starts.size(); j++) {
+            occurrences.push_back(Event(event.getId(), event.getTitle(), starts[j],
+                                        event.getDurationMinutes(), event.getResourceIds()));
         }
     }
     
-    if (selected_resources.empty()) {
-        std::cout << "No valid resources selected!" << std::endl;
-    } else {
-        std::cout << "Selected " << selected_resources.size() << " resource(s)." << std::endl;
+    std::sort(occurrences.begin() + live_count, occurrences.end(), startsBefore);
+    std::inplace_merge(occurrences.begin(), occurrences.begin() + live_count, occurrences.end(), startsBefore);
+}
+
+bool EventManager::listOccurrences(const std::string& from_date, const std::string& to_date,
+                                   std::vector<Event>& occurrences, std::string& error) const {
+    occurrences.clear();
+    long range_start, range_end;
+    if (!parseDateRange(from_date, to_date, range_start, range_end, error)) {
+        return false;
     }
     
-    return selected_resources;
+    std::shared_lock<std::shared_mutex> lock(mutex);
+    std::vector<unsigned int> slots;
+    collectSingles(range_start, range_end, slots);
+    occurrences.reserve(slots.size());
+    for (unsigned int i = 0; i < slots.size(); i++) {
+        occurrences.push_back(events[slots[i]]);
+    }
+    
+    appendSeriesOccurrences(series_ids, range_start, range_end, occurrences);
+    appendArchivedOccurrences(range_start, range_end, 0, occurrences);
+    return true;
 }
 
-void EventManager::addEvent(const std::string& title, const std::string& date,
-                           const std::string& start_time, int duration_minutes, 
-                           const std::vector<unsigned int>& resource_ids) {
-    if (resource_ids.empty()) {
-        std::cout << "Error: No resources selected!" << std::endl;
-        return;
+bool EventManager::listResourceOccurrences(unsigned int resource_id, const std::string& from_date,
+                                           const std::string& to_date, std::vector<Event>& occurrences,
+                                           std::string& error) const {
+    occurrences.clear();
+    long range_start, range_end;
+    if (!parseDateRange(from_date, to_date, range_start, range_end, error)) {
+        return false;
+    }
+    if (!resource_manager->resourceExists(resource_id)) {
+        error = "Resource with ID " + std::to_string(resource_id) + " not found.";
+        return false;
     }
     
-    for (unsigned int i = 0; i < resource_ids.size(); i++) {
-        if (!resource_manager->resourceExists(resource_ids[i])) {
-            std::cout << "Error: Resource with ID " << resource_ids[i] << " does not exist!" << std::endl;
-            return;
-        }
-        
-        Resource* resource = resource_manager->findResource(resource_ids[i]);
-        if (resource != NULL && !resource->isAvailable()) {
-            std::cout << "Error: Resource '" << resource->getName() 
-                      << "' is not available (under maintenance or out of service)." << std::endl;
-            std::cout << "Please select only available resources." << std::endl;
-            return;
+    std::shared_lock<std::shared_mutex> lock(mutex);
+    std::unordered_map<unsigned int, std::multimap<long, BookedSlot> >::const_iterator schedule =
+        resource_schedule.find(resource_id);
+    if (schedule != resource_schedule.end()) {
+        const std::multimap<long, BookedSlot>& slots = schedule->second;
+        std::multimap<long, BookedSlot>::const_iterator it = slots.lower_bound(range_start - longest_duration);
+        for (; it != slots.end() && it->first < range_end; ++it) {
+            if (it->second.end > range_start) {
+                occurrences.push_back(events[id_index.find(it->second.event_id)->second]);
+            }
         }
     }
     
-    if (hasConflict(resource_ids, date, start_time, duration_minutes)) {
-        std::cout << "Error: Time conflict detected! One or more resources are already booked at this time." << std::endl;
+    std::unordered_map<unsigned int, std::vector<unsigned int> >::const_iterator series =
+        resource_series.find(resource_id);
+    if (series != resource_series.end()) {
+        appendSeriesOccurrences(series->second, range_start, range_end, occurrences);
+    }
+    appendArchivedOccurrences(range_start, range_end, resource_id, occurrences);
+    return true;
+}
+
+void EventManager::addEvent(const std::string& title, const std::string& date,
+                           const std::string& start_time, int duration_minutes, 
+                           const std::vector<unsigned int>& resource_ids,
+                           const std::string& recurrence_rule) {
+    std::string error;
+    unsigned int id = createEvent(title, date, start_time, duration_minutes, resource_ids, recurrence_rule, error);
+    if (id == 0) {
+        std::cout << "Error: " << error << std::endl;
         std::cout << "Please choose a different time or different resources." << std::endl;
         return;
     }
     
-    Event new_event(next_id, title, date, start_time, duration_minutes, resource_ids);
-    events.push_back(new_event);
-    
-    std::cout << "Event '" << title << "' added successfully with ID: " << next_id << std::endl;
+    std::cout << "Event '" << title << "' added successfully with ID: " << id << std::endl;
     std::cout << "Resources booked for " << date << " from " << start_time << " to " 
-              << calculateEndTime(start_time, duration_minutes) << ":" << std::endl;
+              << calculateEndTime(toMinuteStamp(date, start_time), duration_minutes) << ":" << std::endl;
+    
+    Event event;
+    if (!recurrence_rule.empty() && lookupEvent(id, event)) {
+        std::cout << "Repeats: " << event.getRecurrence().describe() << std::endl;
+    }
     
     for (unsigned int i = 0; i < resource_ids.size(); i++) {
-        Resource* resource = resource_manager->findResource(resource_ids[i]);
+        const Resource* resource = resource_manager->getResource(resource_ids[i]);
         if (resource != NULL) {
             std::cout << "  - " << resource->getName() << " (ID: " << resource_ids[i] << ")" << std::endl;
         }
     }
-    
-    next_id++;
-    saveToFile();
 }
 
 void EventManager::viewAllEvents() const {
+    std::shared_lock<std::shared_mutex> lock(mutex);
     if (events.empty()) {
         std::cout << "\n=== NO EVENTS FOUND ===" << std::endl;
         std::cout << "No events have been scheduled yet." << std::endl;
@@ -210,18 +1382,27 @@ void EventManager::viewAllEvents() const {
     std::cout << "Total Events: " << events.size() << std::endl;
     std::cout << std::endl;
     
-    for (unsigned int i = 0; i < events.size(); i++) {
-        events[i].displayInfo();
+    std::vector<const Event*> ordered;
+    ordered.reserve(events.size());
+    for (SlabStore<Event>::const_iterator it = events.begin(); it != events.end(); ++it) {
+        ordered.push_back(&*it);
+    }
+    std::sort(ordered.begin(), ordered.end(), [](const Event* a, const Event* b) {
+        return a->getId() < b->getId();
+    });
+    
+    for (unsigned int i = 0; i < ordered.size(); i++) {
+        ordered[i]->displayInfo();
         
-        std::vector<unsigned int> resource_ids = events[i].getResourceIds();
+        const ResourceIdList& resource_ids = ordered[i]->getResourceIds();
         std::cout << "Resources: ";
         if (resource_ids.empty()) {
             std::cout << "None";
         } else {
+            Resource resource;
             for (unsigned int j = 0; j < resource_ids.size(); j++) {
-                Resource* resource = resource_manager->findResource(resource_ids[j]);
-                if (resource != NULL) {
-                    std::cout << resource->getName();
+                if (resource_manager->lookupResource(resource_ids[j], resource)) {
+                    std::cout << resource.getName();
                     if (j < resource_ids.size() - 1) {
                         std::cout << ", ";
                     }
@@ -248,9 +1429,6 @@ void EventManager::updateEvent(unsigned int id) {
     std::cout << "New title (current: " << event->getTitle() << "): ";
     std::string new_title;
     std::getline(std::cin, new_title);
-    if (!new_title.empty()) {
-        event->setTitle(new_title);
-    }
     
     std::cout << "New date [YYYY-MM-DD] (current: " << event->getDate() << "): ";
     std::string new_date;
@@ -291,41 +1469,22 @@ void EventManager::updateEvent(unsigned int id) {
     std::string update_resources;
     std::getline(std::cin, update_resources);
     
-    std::vector<unsigned int> new_resource_ids = event->getResourceIds();
+    std::vector<unsigned int> new_resource_ids;
     
     if (update_resources == "y" || update_resources == "Y") {
         new_resource_ids = selectMultipleResourcesInteractive();
         if (new_resource_ids.empty()) {
             std::cout << "Error: No valid resources selected. Keeping current resources." << std::endl;
-            new_resource_ids = event->getResourceIds();
-        }
-    }
-    
-    for (unsigned int i = 0; i < new_resource_ids.size(); i++) {
-        Resource* resource = resource_manager->findResource(new_resource_ids[i]);
-        if (resource != NULL && !resource->isAvailable()) {
-            std::cout << "Error: Resource '" << resource->getName() 
-                      << "' is not available. Update cancelled." << std::endl;
-            return;
         }
     }
     
-    std::string check_date = new_date.empty() ? event->getDate() : new_date;
-    std::string check_time = new_start_time.empty() ? event->getStartTime() : new_start_time;
-    int check_duration = duration_str.empty() ? event->getDurationMinutes() : new_duration;
-    
-    if (hasConflict(new_resource_ids, check_date, check_time, check_duration, event->getId())) {
-        std::cout << "Error: Update would cause a time conflict! Changes not saved." << std::endl;
+    std::string error;
+    if (!modifyEvent(id, new_title, new_date, new_start_time, new_duration, new_resource_ids, error)) {
+        std::cout << "Error: " << error << " Changes not saved." << std::endl;
         return;
     }
     
-    if (!new_date.empty()) event->setDate(new_date);
-    if (!new_start_time.empty()) event->setStartTime(new_start_time);
-    if (!duration_str.empty()) event->setDurationMinutes(check_duration);
-    event->setResourceIds(new_resource_ids);
-    
     std::cout << "Event updated successfully!" << std::endl;
-    saveToFile();
 }
 
 void EventManager::updateEventByTitle(const std::string& title) {
@@ -338,17 +1497,19 @@ void EventManager::updateEventByTitle(const std::string& title) {
 }
 
 void EventManager::deleteEvent(unsigned int id) {
-    for (unsigned int i = 0; i < events.size(); i++) {
-        if (events[i].getId() == id) {
-            std::string event_title = events[i].getTitle();
-            std::cout << "Deleting event: " << event_title << " (ID: " << id << ")" << std::endl;
-            events.erase(events.begin() + i);
-            std::cout << "Event deleted successfully." << std::endl;
-            saveToFile();
-            return;
-        }
+    std::unordered_map<unsigned int, unsigned int>::const_iterator it = id_index.find(id);
+    if (it == id_index.end()) {
+        std::cout << "Error: Event with ID " << id << " not found." << std::endl;
+        return;
     }
-    std::cout << "Error: Event with ID " << id << " not found." << std::endl;
+    
+    std::cout << "Deleting event: " << events[it->second].getTitle() << " (ID: " << id << ")" << std::endl;
+    std::string error;
+    if (!removeEvent(id, error)) {
+        std::cout << "Error: " << error << std::endl;
+        return;
+    }
+    std::cout << "Event deleted successfully." << std::endl;
 }
 
 void EventManager::deleteEventByTitle(const std::string& title) {
@@ -423,116 +1584,371 @@ bool EventManager::isValidTime(const std::string& time) const {
 }
 
 int EventManager::getEventCount() const {
+    std::shared_lock<std::shared_mutex> lock(mutex);
     return events.size();
 }
 
-bool EventManager::eventExists(unsigned int id) const {
-    for (unsigned int i = 0; i < events.size(); i++) {
-        if (events[i].getId() == id) {
-            return true;
+void EventManager::indexLookups(unsigned int slot) {
+    id_index[events[slot].getId()] = slot;
+    title_index.insert(std::make_pair(events[slot].getTitle(), slot));
+}
+
+void EventManager::unindexLookups(unsigned int slot) {
+    id_index.erase(events[slot].getId());
+    std::pair<std::unordered_multimap<std::string, unsigned int, CaseInsensitiveHash, CaseInsensitiveEqual>::iterator,
+              std::unordered_multimap<std::string, unsigned int, CaseInsensitiveHash, CaseInsensitiveEqual>::iterator>
+        range = title_index.equal_range(events[slot].getTitle());
+    for (std::unordered_multimap<std::string, unsigned int, CaseInsensitiveHash, CaseInsensitiveEqual>::iterator it =
+             range.first; it != range.second; ++it) {
+        if (it->second == slot) {
+            title_index.erase(it);
+            return;
         }
     }
-    return false;
 }
 
-bool EventManager::eventExistsByTitle(const std::string& title) const {
-    std::string search_lower = toLowercase(title);
-    for (unsigned int i = 0; i < events.size(); i++) {
-        if (toLowercase(events[i].getTitle()) == search_lower) {
-            return true;
+bool EventManager::findTitleSlot(const std::string& title, unsigned int& slot) const {
+    std::pair<std::unordered_multimap<std::string, unsigned int, CaseInsensitiveHash, CaseInsensitiveEqual>::const_iterator,
+              std::unordered_multimap<std::string, unsigned int, CaseInsensitiveHash, CaseInsensitiveEqual>::const_iterator>
+        range = title_index.equal_range(title);
+    if (range.first == range.second) {
+        return false;
+    }
+    
+    slot = range.first->second;
+    for (std::unordered_multimap<std::string, unsigned int, CaseInsensitiveHash, CaseInsensitiveEqual>::const_iterator it =
+             range.first; it != range.second; ++it) {
+        if (events[it->second].getId() < events[slot].getId()) {
+            slot = it->second;
         }
     }
-    return false;
+    return true;
 }
 
-Event* EventManager::findEvent(unsigned int id) {
-    for (unsigned int i = 0; i < events.size(); i++) {
-        if (events[i].getId() == id) {
-            return &events[i];
+void EventManager::rebuildLookups() {
+    std::thread title_builder([this]() {
+        title_index.clear();
+        title_index.reserve(events.size());
+        for (SlabStore<Event>::const_iterator it = events.begin(); it != events.end(); ++it) {
+            title_index.insert(std::make_pair(it->getTitle(), it.getSlot()));
         }
+    });
+    
+    id_index.clear();
+    id_index.reserve(events.size());
+    for (SlabStore<Event>::const_iterator it = events.begin(); it != events.end(); ++it) {
+        id_index[it->getId()] = it.getSlot();
+    }
+    title_builder.join();
+}
+
+bool EventManager::eventExists(unsigned int id) const {
+    std::shared_lock<std::shared_mutex> lock(mutex);
+    return id_index.find(id) != id_index.end() || archive.contains(id);
+}
+
+bool EventManager::eventExistsByTitle(const std::string& title) const {
+    std::shared_lock<std::shared_mutex> lock(mutex);
+    return title_index.find(title) != title_index.end();
+}
+
+Event* EventManager::findEvent(unsigned int id) {
+    std::unordered_map<unsigned int, unsigned int>::const_iterator it = id_index.find(id);
+    if (it == id_index.end()) {
+        return NULL;
     }
-    return NULL;
+    return &events[it->second];
 }
 
 Event* EventManager::findEventByTitle(const std::string& title) {
-    std::string search_lower = toLowercase(title);
-    for (unsigned int i = 0; i < events.size(); i++) {
-        if (toLowercase(events[i].getTitle()) == search_lower) {
-            return &events[i];
-        }
+    unsigned int slot;
+    if (!findTitleSlot(title, slot)) {
+        return NULL;
+    }
+    return &events[slot];
+}
+
+void EventManager::setAutoSave(bool enabled) {
+    std::unique_lock<std::shared_mutex> lock(mutex);
+    auto_save = enabled;
+}
+
+bool EventManager::journalChange(char operation, const std::string& payload, std::string& error) {
+    return journalChange(operation, std::vector<std::string>(1, payload), error);
+}
+
+bool EventManager::journalChange(char operation, const std::vector<std::string>& payloads, std::string& error) {
+    if (!auto_save || journal.append(operation, payloads)) {
+        return true;
+    }
+    error = "Could not save the change to " + journal.getLogFile() + ", so nothing was changed.";
+    return false;
+}
+
+void EventManager::recordChange(unsigned int id) {
+    markDirty(id);
+    compactLargeJournal();
+}
+
+void EventManager::compactLargeJournal() {
+    if (auto_save && journal.getEntryCount() >= MIN_JOURNAL_ENTRIES_BEFORE_COMPACTION &&
+        journal.getEntryCount() >= events.size()) {
+        std::string error;
+        compactJournal(error);
     }
-    return NULL;
 }
 
-void EventManager::saveToFile() const {
-    std::ofstream file(data_file);
+void EventManager::markDirty(unsigned int id) {
+    dirty_ids.insert(id);
+}
+
+bool EventManager::hasUnsavedChanges() const {
+    std::shared_lock<std::shared_mutex> lock(mutex);
+    return !dirty_ids.empty() || journal.getEntryCount() > 0;
+}
+
+bool EventManager::compactJournal(std::string& error) {
+    if (!backend->canCommitChanges()) {
+        return writeStore(*backend, error);
+    }
     
-    if (!file.is_open()) {
-        return;
+    std::vector<unsigned int> changed(dirty_ids.begin(), dirty_ids.end());
+    std::sort(changed.begin(), changed.end());
+    std::vector<const Event*> puts;
+    std::vector<unsigned int> removals;
+    
+    for (unsigned int i = 0; i < changed.size(); i++) {
+        std::unordered_map<unsigned int, unsigned int>::const_iterator it = id_index.find(changed[i]);
+        if (it != id_index.end()) {
+            puts.push_back(&events[it->second]);
+        } else {
+            removals.push_back(changed[i]);
+        }
+    }
+    
+    if (!backend->commit(puts, removals)) {
+        return writeStore(*backend, error);
+    }
+    return clearJournal(error);
+}
+
+bool EventManager::save(std::string& error) {
+    std::unique_lock<std::shared_mutex> lock(mutex);
+    return compactJournal(error);
+}
+
+bool EventManager::saveAs(StorageFormat format, std::string& error) {
+    std::unique_lock<std::shared_mutex> lock(mutex);
+    if (stores[format] == backend) {
+        return compactJournal(error);
+    }
+    return writeStore(*stores[format], error);
+}
+
+bool EventManager::flushChanges(std::string& error) {
+    std::unique_lock<std::shared_mutex> lock(mutex);
+    if (backend->canCommitChanges() && auto_save && !dirty_ids.empty()) {
+        return compactJournal(error);
+    }
+    return true;
+}
+
+void EventManager::adoptRecords(std::vector<Event>& loaded) {
+    events.clear();
+    events.reserve(loaded.size());
+    for (unsigned int i = 0; i < loaded.size(); i++) {
+        events.insert(std::move(loaded[i]));
+    }
+    loaded.clear();
+}
+
+bool EventManager::writeStore(StorageBackend<Event>& store, std::string& error) {
+    std::vector<const Event*> records;
+    records.reserve(events.size());
+    for (SlabStore<Event>::const_iterator it = events.begin(); it != events.end(); ++it) {
+        records.push_back(&*it);
     }
     
-    for (unsigned int i = 0; i < events.size(); i++) {
-        file << events[i].toString() << std::endl;
+    if (!store.rewrite(records)) {
+        error = "Cannot write '" + store.getPath() + "'.";
+        return false;
     }
     
-    file.close();
+    backend = &store;
+    return clearJournal(error);
 }
 
-void EventManager::loadFromFile() {
-    std::ifstream file(data_file);
+bool EventManager::clearJournal(std::string& error) {
+    dirty_ids.clear();
+    if (!journal.reset()) {
+        error = "Cannot clear the journal '" + journal.getLogFile() + "'.";
+        return false;
+    }
+    return true;
+}
+
+bool EventManager::loadFrom(StorageFormat format) {
+    std::unique_lock<std::shared_mutex> lock(mutex);
+    std::vector<Event> loaded;
+    std::vector<DamagedRecord> damaged;
+    if (!stores[format]->load(loaded, damaged)) {
+        return false;
+    }
     
-    if (!file.is_open()) {
-        return;
+    damaged_count = 0;
+    for (unsigned int i = 0; i < damaged.size(); i++) {
+        quarantine(damaged[i].origin, damaged[i].raw);
     }
     
-    std::vector<Event> temp_events;
-    std::string line;
     unsigned int max_id = 0;
+    for (unsigned int i = 0; i < loaded.size(); i++) {
+        max_id = (loaded[i].getId() > max_id) ? loaded[i].getId() : max_id;
+    }
     
-    while (std::getline(file, line)) {
-        std::vector<std::string> parts;
-        std::stringstream ss(line);
-        std::string part;
-        
-        while (std::getline(ss, part, '|')) {
-            parts.push_back(part);
-        }
-        
-        if (parts.size() != 6) {
-            file.close();
+    adoptRecords(loaded);
+    backend = stores[format];
+    finishLoad(max_id);
+    return true;
+}
+
+void EventManager::load() {
+    for (unsigned int i = 0; i + 1 < STORAGE_FORMAT_COUNT; i++) {
+        StorageFormat format = STORAGE_LOAD_ORDER[i];
+        if (stores[format]->exists() && loadFrom(format)) {
             return;
         }
+    }
+    loadFrom(STORAGE_LOAD_ORDER[STORAGE_FORMAT_COUNT - 1]);
+}
+
+StorageFormat EventManager::getStorageFormat() const {
+    std::shared_lock<std::shared_mutex> lock(mutex);
+    return backend->getFormat();
+}
+
+std::string EventManager::getStorePath(StorageFormat format) const {
+    return stores[format]->getPath();
+}
+
+void EventManager::quarantine(const std::string& origin, std::string_view raw) {
+    quarantineRecord(quarantine_file, origin, raw);
+    damaged_count++;
+}
+
+unsigned int EventManager::getDamagedRecordCount() const {
+    std::shared_lock<std::shared_mutex> lock(mutex);
+    return damaged_count;
+}
+
+std::string EventManager::getQuarantineFile() const {
+    return quarantine_file;
+}
+
+unsigned int EventManager::getArchivedCount() const {
+    std::shared_lock<std::shared_mutex> lock(mutex);
+    return archive.size();
+}
+
+std::string EventManager::getArchiveFile() const {
+    return archive.getPath();
+}
+
+bool EventManager::isArchiveDamaged() const {
+    std::shared_lock<std::shared_mutex> lock(mutex);
+    return archive.isDamaged();
+}
+
+void EventManager::setArchiveCacheCapacity(std::size_t capacity) {
+    archive.setCacheCapacity(capacity);
+}
+
+void EventManager::finishLoad(unsigned int max_id) {
+    dirty_ids.clear();
+    rebuildLookups();
+    
+    unsigned int journal_max_id = replayJournal();
+    max_id = (journal_max_id > max_id) ? journal_max_id : max_id;
+    if (!archive.open() && archive.isDamaged()) {
+        quarantineRecord(quarantine_file, archive.getPath(), "archive footer or index failed its check; the file was kept");
+    }
+    if (archive.hasTornTail()) {
+        quarantineRecord(quarantine_file, archive.getPath(), "archive tail after the last complete segment failed its check; "
+                         "the next archive run replaces it");
+    }
+    max_id = (archive.getMaxId() > max_id) ? archive.getMaxId() : max_id;
+    next_id = max_id + 1;
+    std::string error;
+    if (damaged_count > 0 && !writeStore(*backend, error)) {
+        std::cerr << "Warning: " << error << std::endl;
+    }
+    std::thread schedule_builder(&EventManager::rebuildSchedule, this);
+    
+    std::vector<std::pair<unsigned int, std::string_view> > titles;
+    titles.reserve(events.size());
+    for (SlabStore<Event>::const_iterator it = events.begin(); it != events.end(); ++it) {
+        titles.push_back(std::make_pair(it->getId(), std::string_view(it->getTitle())));
+    }
+    title_trigrams.clear();
+    title_trigrams.addAll(titles);
+    schedule_builder.join();
+}
+
+unsigned int EventManager::replayJournal() {
+    std::vector<std::string> damaged;
+    std::vector<std::string> entries = journal.readEntries(damaged);
+    for (unsigned int i = 0; i < damaged.size(); i++) {
+        quarantine(journal.getLogFile(), damaged[i]);
+    }
+    unsigned int max_id = 0;
+    
+    for (unsigned int i = 0; i < entries.size(); i++) {
+        std::string_view payload = std::string_view(entries[i]).substr(2);
         
-        unsigned int id;
-        std::stringstream(parts[0]) >> id;
-        
-        int duration;
-        std::stringstream(parts[4]) >> duration;
-        
-        std::vector<unsigned int> resource_ids;
-        std::stringstream resource_ss(parts[5]);
-        std::string resource_id_str;
-        
-        while (std::getline(resource_ss, resource_id_str, ',')) {
-            unsigned int resource_id;
-            std::stringstream id_ss(resource_id_str);
-            id_ss >> resource_id;
-            resource_ids.push_back(resource_id);
+        if (entries[i][0] == Journal::PUT) {
+            Event event;
+            if (!codec.parseLine(payload, event)) {
+                quarantine(journal.getLogFile(), entries[i]);
+                continue;
+            }
+            
+            std::unordered_map<unsigned int, unsigned int>::iterator it = id_index.find(event.getId());
+            if (it != id_index.end()) {
+                unsigned int slot = it->second;
+                unindexLookups(slot);
+                events[slot] = event;
+                indexLookups(slot);
+            } else {
+                indexLookups(events.insert(event).slot);
+            }
+            markDirty(event.getId());
+            max_id = (event.getId() > max_id) ? event.getId() : max_id;
+        } else if (entries[i][0] == Journal::REMOVE) {
+            unsigned int id;
+            if (!parseUnsigned(payload, id)) {
+                quarantine(journal.getLogFile(), entries[i]);
+                continue;
+            }
+            
+            std::unordered_map<unsigned int, unsigned int>::iterator it = id_index.find(id);
+            if (it != id_index.end()) {
+                unsigned int slot = it->second;
+                unindexLookups(slot);
+                events.erase(slot);
+            }
+            markDirty(id);
+            max_id = (id > max_id) ? id : max_id;
         }
-        
-        Event loaded_event(id, parts[1], parts[2], parts[3], duration, resource_ids);
-        temp_events.push_back(loaded_event);
-        
-        max_id = (id > max_id) ? id : max_id;
     }
     
-    file.close();
-    events = temp_events;
-    next_id = max_id + 1;
+    return max_id;
 }
 
 void EventManager::searchEventById(unsigned int id) const {
-    Event* event = const_cast<EventManager*>(this)->findEvent(id);
+    Event archived;
+    const Event* event = getEvent(id);
+    if (event == NULL && archive.find(id, archived)) {
+        event = &archived;
+    }
     
     if (event == NULL) {
         std::cout << "No event found with ID " << id << std::endl;
@@ -541,7 +1957,7 @@ void EventManager::searchEventById(unsigned int id) const {
         std::cout << "Found 1 event matching ID " << id << ":" << std::endl;
         event->displayInfo();
         
-        std::vector<unsigned int> resource_ids = event->getResourceIds();
+        const ResourceIdList& resource_ids = event->getResourceIds();
         std::cout << "Resources: ";
         if (resource_ids.empty()) {
             std::cout << "None";
@@ -561,33 +1977,118 @@ void EventManager::searchEventById(unsigned int id) const {
     }
 }
 
-void EventManager::searchEventByTitle(const std::string& title) const {
-    std::vector<Event> found_events;
-    std::string search_lower = toLowercase(title);
+std::vector<unsigned int> EventManager::matchEventsByTitle(const std::string& title) const {
+    std::shared_lock<std::shared_mutex> lock(mutex);
+    return matchTitle(toLowercase(title));
+}
+
+std::vector<unsigned int> EventManager::matchTitle(const std::string& search_lower) const {
+    std::vector<unsigned int> matches;
     
-    for (unsigned int i = 0; i < events.size(); i++) {
-        std::string title_lower = toLowercase(events[i].getTitle());
-        
-        if (title_lower.find(search_lower) != std::string::npos) {
-            found_events.push_back(events[i]);
+    if (title_trigrams.findCandidates(search_lower, matches)) {
+        if (search_lower.length() == TrigramIndex::TRIGRAM_LENGTH) {
+            return matches;
         }
+        std::vector<unsigned int>::size_type kept = 0;
+        for (unsigned int i = 0; i < matches.size(); i++) {
+            if (containsIgnoreCase(events[id_index.find(matches[i])->second].getTitle(), search_lower)) {
+                matches[kept++] = matches[i];
+            }
+        }
+        matches.resize(kept);
+        return matches;
+    }
+    
+    for (SlabStore<Event>::const_iterator it = events.begin(); it != events.end(); ++it) {
+        if (containsIgnoreCase(it->getTitle(), search_lower)) {
+            matches.push_back(it->getId());
+        }
+    }
+    return matches;
+}
+
+std::vector<FuzzyMatch> EventManager::fuzzyMatchEventsByTitle(const std::string& title,
+                                                              unsigned int max_results) const {
+    std::shared_lock<std::shared_mutex> lock(mutex);
+    std::string search_lower = toLowercase(title);
+    std::vector<unsigned int> candidates;
+    int max_distance = title_trigrams.findSimilarCandidates(search_lower, candidates);
+    
+    if (max_distance == 0) {
+        candidates = matchTitle(search_lower);
+    }
+    
+    FuzzyRanker ranker(search_lower, max_distance, max_results);
+    for (unsigned int i = 0; i < candidates.size(); i++) {
+        ranker.consider(candidates[i], events[id_index.find(candidates[i])->second].getTitle());
+    }
+    return ranker.finish();
+}
+
+const Event* EventManager::getEvent(unsigned int id) const {
+    std::unordered_map<unsigned int, unsigned int>::const_iterator it = id_index.find(id);
+    if (it == id_index.end()) {
+        return NULL;
+    }
+    return &events[it->second];
+}
+
+SlabHandle EventManager::getEventHandle(unsigned int id) const {
+    std::shared_lock<std::shared_mutex> lock(mutex);
+    std::unordered_map<unsigned int, unsigned int>::const_iterator it = id_index.find(id);
+    if (it == id_index.end()) {
+        return NULL_HANDLE;
+    }
+    return events.handleAt(it->second);
+}
+
+Event* EventManager::findEvent(SlabHandle handle) {
+    return events.get(handle);
+}
+
+const Event* EventManager::getEvent(SlabHandle handle) const {
+    return events.get(handle);
+}
+
+bool EventManager::lookupEvent(unsigned int id, Event& event) const {
+    std::shared_lock<std::shared_mutex> lock(mutex);
+    std::unordered_map<unsigned int, unsigned int>::const_iterator it = id_index.find(id);
+    if (it == id_index.end()) {
+        return archive.find(id, event);
     }
+    event = events[it->second];
+    return true;
+}
+
+void EventManager::searchEventByTitle(const std::string& title) const {
+    std::vector<unsigned int> found_ids = matchEventsByTitle(title);
     
-    if (found_events.empty()) {
+    if (found_ids.empty()) {
         std::cout << "No events found matching title '" << title << "'" << std::endl;
+        
+        std::vector<FuzzyMatch> suggestions = fuzzyMatchEventsByTitle(title, MAX_SUGGESTIONS);
+        if (!suggestions.empty()) {
+            std::cout << "Did you mean:" << std::endl;
+            for (unsigned int i = 0; i < suggestions.size(); i++) {
+                const Event* event = getEvent(suggestions[i].id);
+                std::cout << "  - " << event->getTitle() << " on " << event->getDate() << " (ID: " << suggestions[i].id
+                          << ", " << suggestions[i].distance << " typo(s))" << std::endl;
+            }
+        }
     } else {
         std::cout << "\n=== SEARCH RESULTS ===" << std::endl;
-        std::cout << "Found " << found_events.size() << " event(s) matching title '" << title << "':" << std::endl;
-        for (unsigned int i = 0; i < found_events.size(); i++) {
-            found_events[i].displayInfo();
+        std::cout << "Found " << found_ids.size() << " event(s) matching title '" << title << "':" << std::endl;
+        for (unsigned int i = 0; i < found_ids.size(); i++) {
+            const Event* event = getEvent(found_ids[i]);
+            event->displayInfo();
             
-            std::vector<unsigned int> resource_ids = found_events[i].getResourceIds();
+            const ResourceIdList& resource_ids = event->getResourceIds();
             std::cout << "Resources: ";
             if (resource_ids.empty()) {
                 std::cout << "None";
             } else {
                 for (unsigned int j = 0; j < resource_ids.size(); j++) {
-                    Resource* resource = resource_manager->findResource(resource_ids[j]);
+                    const Resource* resource = resource_manager->getResource(resource_ids[j]);
                     if (resource != NULL) {
                         std::cout << resource->getName();
                         if (j < resource_ids.size() - 1) {
@@ -0,0 +1,118 @@
+#include "Journal.hpp"
+#include "DurableFile.hpp"
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+
+Journal::Journal(const std::string& log_file) {
+    this->log_file = log_file;
+    stream = NULL;
+    entry_count = 0;
+}
+
+Journal::~Journal() {
+    if (stream != NULL) {
+        std::fclose(stream);
+    }
+}
+
+bool Journal::append(char operation, const std::string& payload) {
+    return append(operation, std::vector<std::string>(1, payload));
+}
+
+bool Journal::append(char operation, const std::vector<std::string>& payloads) {
+    if (stream == NULL) {
+        stream = std::fopen(log_file.c_str(), "ab");
+        if (stream == NULL) {
+            return false;
+        }
+    }
+    
+    std::string lines;
+    for (unsigned int i = 0; i < payloads.size(); i++) {
+        std::string line(1, operation);
+        line += '|';
+        line += payloads[i];
+        appendChecksum(line);
+        lines += line;
+        lines += '\n';
+    }
+    
+    long offset = std::fseek(stream, 0, SEEK_END) == 0 ? std::ftell(stream) : -1;
+    if (!writeBytes(stream, lines) || !syncFile(stream)) {
+        std::fclose(stream);
+        stream = NULL;
+        if (offset >= 0) {
+            std::error_code error;
+            std::filesystem::resize_file(log_file, offset, error);
+        }
+        return false;
+    }
+    entry_count += payloads.size();
+    return true;
+}
+
+std::vector<std::string> Journal::readEntries(std::vector<std::string>& damaged) {
+    std::vector<std::string> entries;
+    damaged.clear();
+    std::ifstream file(log_file, std::ios::in | std::ios::binary);
+    
+    if (!file.is_open()) {
+        entry_count = 0;
+        return entries;
+    }
+    
+    std::stringstream buffer;
+    buffer << file.rdbuf();
+    std::string content = buffer.str();
+    file.close();
+    
+    std::string::size_type line_start = 0;
+    std::string::size_type line_end = content.find('\n');
+    
+    while (line_end != std::string::npos) {
+        std::string_view line(content.data() + line_start, line_end - line_start);
+        ChecksumState state = stripChecksum(line);
+        
+        if (state != CHECKSUM_INVALID && line.size() > 2 && line[1] == '|') {
+            entries.push_back(std::string(line));
+        } else if (!line.empty()) {
+            damaged.push_back(content.substr(line_start, line_end - line_start));
+        }
+        line_start = line_end + 1;
+        line_end = content.find('\n', line_start);
+    }
+    
+    if (line_start < content.size()) {
+        std::error_code error;
+        std::filesystem::resize_file(log_file, line_start, error);
+    }
+    
+    entry_count = entries.size();
+    return entries;
+}
+
+bool Journal::reset() {
+    if (stream != NULL) {
+        std::fclose(stream);
+        stream = NULL;
+    }
+    
+    crashIfFaultReached();
+    std::FILE* truncated = std::fopen(log_file.c_str(), "wb");
+    if (truncated == NULL) {
+        return false;
+    }
+    bool synced = syncFile(truncated);
+    bool closed = std::fclose(truncated) == 0;
+    entry_count = 0;
+    return synced && closed;
+}
+
+unsigned int Journal::getEntryCount() const {
+    return entry_count;
+}
+
+std::string Journal::getLogFile() const {
+    return log_file;
+}
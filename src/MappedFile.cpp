@@ -0,0 +1,83 @@
+#include "MappedFile.hpp"
+#include <fstream>
+#include <sstream>
+#ifndef _WIN32
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <fcntl.h>
+    #include <unistd.h>
+#endif
+
+MappedFile::MappedFile() {
+    data = NULL;
+    length = 0;
+    is_mapped = false;
+}
+
+MappedFile::~MappedFile() {
+    close();
+}
+
+bool MappedFile::open(const std::string& path) {
+    close();
+    
+    #ifndef _WIN32
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) {
+            return false;
+        }
+        
+        struct stat info;
+        if (fstat(fd, &info) != 0) {
+            ::close(fd);
+            return false;
+        }
+        
+        if (info.st_size > 0) {
+            void* mapping = mmap(NULL, info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (mapping != MAP_FAILED) {
+                madvise(mapping, info.st_size, MADV_SEQUENTIAL);
+                data = static_cast<const char*>(mapping);
+                length = info.st_size;
+                is_mapped = true;
+            }
+        }
+        ::close(fd);
+        
+        if (is_mapped || info.st_size == 0) {
+            return true;
+        }
+    #endif
+    
+    std::ifstream file(path, std::ios::in | std::ios::binary);
+    if (!file.is_open()) {
+        return false;
+    }
+    
+    std::stringstream buffer;
+    buffer << file.rdbuf();
+    fallback_buffer = buffer.str();
+    data = fallback_buffer.data();
+    length = fallback_buffer.size();
+    return true;
+}
+
+void MappedFile::close() {
+    #ifndef _WIN32
+        if (is_mapped) {
+            munmap(const_cast<char*>(data), length);
+        }
+    #endif
+    
+    data = NULL;
+    length = 0;
+    is_mapped = false;
+    fallback_buffer.clear();
+}
+
+std::string_view MappedFile::view() const {
+    if (data == NULL) {
+        return std::string_view();
+    }
+    return std::string_view(data, length);
+}
@@ -0,0 +1,502 @@
+#include "PagedFile.hpp"
+#include "BinarySnapshot.hpp"
+#include "DurableFile.hpp"
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+
+static const std::size_t PAGE_CAPACITY = PagedFile::PAGE_SIZE - PagedFile::PAGE_HEADER_SIZE;
+
+static void storeU32(std::string& page, std::size_t offset, uint32_t value) {
+    for (int i = 0; i < 4; i++) {
+        page[offset + i] = static_cast<char>((value >> (8 * i)) & 0xFF);
+    }
+}
+
+static std::string makeEmptyPage(uint32_t span) {
+    std::string page(span * PagedFile::PAGE_SIZE, '\0');
+    storeU32(page, 4, span);
+    return page;
+}
+
+static std::size_t findEntry(const std::string& page, unsigned int id, std::size_t& entry_size) {
+    uint32_t count = readU32(page.data());
+    std::size_t offset = PagedFile::PAGE_HEADER_SIZE;
+
+    for (uint32_t i = 0; i < count; i++) {
+        std::size_t size = PagedFile::ENTRY_HEADER_SIZE + readU32(page.data() + offset + 4);
+        if (readU32(page.data() + offset) == id) {
+            entry_size = size;
+            return offset;
+        }
+        offset += size;
+    }
+    entry_size = 0;
+    return 0;
+}
+
+static uint32_t repackPage(std::string& page, unsigned int id, const std::string* payload) {
+    std::size_t entry_size;
+    std::size_t entry_offset = findEntry(page, id, entry_size);
+    uint32_t count = readU32(page.data());
+    std::size_t used = PagedFile::PAGE_HEADER_SIZE;
+    for (uint32_t i = 0; i < count; i++) {
+        used += PagedFile::ENTRY_HEADER_SIZE + readU32(page.data() + used + 4);
+    }
+
+    if (entry_size != 0) {
+        page.erase(entry_offset, entry_size);
+        page.append(entry_size, '\0');
+        used -= entry_size;
+        count--;
+    }
+    if (payload != NULL) {
+        storeU32(page, used, id);
+        storeU32(page, used + 4, payload->size());
+        page.replace(used + PagedFile::ENTRY_HEADER_SIZE, payload->size(), *payload);
+        used += PagedFile::ENTRY_HEADER_SIZE + payload->size();
+        count++;
+    }
+
+    storeU32(page, 0, count);
+    return used - PagedFile::PAGE_HEADER_SIZE;
+}
+
+PagedFile::PagedFile(const std::string& path, const char* magic) {
+    this->path = path;
+    batch_path = path + ".dw";
+    std::memcpy(this->magic, magic, 4);
+    fill_page = 0;
+    sequence = 0;
+    last_write_bytes = 0;
+}
+
+uint32_t PagedFile::findPage(unsigned int id) const {
+    return id < record_pages.size() ? record_pages[id] : 0;
+}
+
+void PagedFile::setPage(unsigned int id, uint32_t page) {
+    if (id >= record_pages.size()) {
+        record_pages.resize(id + 1 + id / 2, 0);
+    }
+    record_pages[id] = page;
+}
+
+std::string* PagedFile::loadPage(std::FILE* file, uint32_t page, std::map<uint32_t, std::string>& cache) {
+    std::map<uint32_t, std::string>::iterator it = cache.find(page);
+    if (it != cache.end()) {
+        return &it->second;
+    }
+
+    std::string bytes(pages[page].span * PAGE_SIZE, '\0');
+    if (std::fseek(file, static_cast<long>(page) * PAGE_SIZE, SEEK_SET) != 0 ||
+        std::fread(&bytes[0], 1, bytes.size(), file) != bytes.size()) {
+        return NULL;
+    }
+    return &(cache[page] = bytes);
+}
+
+bool PagedFile::removeEntry(std::FILE* file, uint32_t page, unsigned int id,
+                            std::map<uint32_t, std::string>& cache) {
+    uint32_t span = pages[page].span;
+    if (span > 1) {
+        cache.erase(page);
+        for (uint32_t i = 0; i < span; i++) {
+            pages[page + i].used = 0;
+            pages[page + i].span = 1;
+            cache[page + i] = makeEmptyPage(1);
+            empty_pages.push_back(page + i);
+        }
+        return true;
+    }
+
+    std::string* bytes = loadPage(file, page, cache);
+    if (bytes == NULL) {
+        return false;
+    }
+    pages[page].used = repackPage(*bytes, id, NULL);
+    if (pages[page].used == 0) {
+        empty_pages.push_back(page);
+    }
+    return true;
+}
+
+bool PagedFile::placeEntry(std::FILE* file, uint32_t page, unsigned int id, const std::string& payload,
+                           std::map<uint32_t, std::string>& cache, bool& placed) {
+    placed = false;
+    if (pages[page].span != 1) {
+        return true;
+    }
+
+    std::string* bytes = loadPage(file, page, cache);
+    if (bytes == NULL) {
+        return false;
+    }
+    std::size_t old_size;
+    findEntry(*bytes, id, old_size);
+    if (pages[page].used - old_size + ENTRY_HEADER_SIZE + payload.size() > PAGE_CAPACITY) {
+        return true;
+    }
+
+    pages[page].used = repackPage(*bytes, id, &payload);
+    placed = true;
+    return true;
+}
+
+uint32_t PagedFile::allocatePage(std::size_t entry_size, std::map<uint32_t, std::string>& cache) {
+    if (entry_size > PAGE_CAPACITY) {
+        uint32_t span = (entry_size + PAGE_HEADER_SIZE + PAGE_SIZE - 1) / PAGE_SIZE;
+        uint32_t head = pages.size();
+        pages.push_back(PageInfo{0, span});
+        for (uint32_t i = 1; i < span; i++) {
+            pages.push_back(PageInfo{0, 0});
+        }
+        cache[head] = makeEmptyPage(span);
+        return head;
+    }
+
+    if (fill_page != 0 && pages[fill_page].span == 1 && pages[fill_page].used + entry_size <= PAGE_CAPACITY) {
+        return fill_page;
+    }
+
+    while (!empty_pages.empty()) {
+        uint32_t page = empty_pages.back();
+        empty_pages.pop_back();
+        if (pages[page].span == 1 && pages[page].used == 0) {
+            fill_page = page;
+            return page;
+        }
+    }
+
+    fill_page = pages.size();
+    pages.push_back(PageInfo{0, 1});
+    cache[fill_page] = makeEmptyPage(1);
+    return fill_page;
+}
+
+void PagedFile::writeHeaderPage(std::string& out) const {
+    std::string header(PAGE_SIZE, '\0');
+    std::memcpy(&header[0], magic, 4);
+    storeU32(header, 4, VERSION);
+    storeU32(header, 8, PAGE_SIZE);
+    out += header;
+}
+
+bool PagedFile::recover() {
+    std::ifstream input(batch_path, std::ios::in | std::ios::binary);
+    if (!input.is_open()) {
+        return true;
+    }
+
+    std::stringstream buffer;
+    buffer << input.rdbuf();
+    std::string batch = buffer.str();
+    input.close();
+
+    bool valid = batch.size() >= 12 && std::memcmp(batch.data(), magic, 4) == 0 &&
+                 readU32(batch.data() + batch.size() - 4) == crc32(std::string_view(batch).substr(0, batch.size() - 4));
+    std::size_t offset = 8;
+    uint32_t count = valid ? readU32(batch.data() + 4) : 0;
+    for (uint32_t i = 0; i < count && valid; i++) {
+        valid = offset + 8 <= batch.size() - 4 && readU32(batch.data() + offset + 4) <= batch.size() - 4 - offset - 8;
+        offset += valid ? 8 + readU32(batch.data() + offset + 4) : 0;
+    }
+
+    std::FILE* file = valid ? std::fopen(path.c_str(), "r+b") : NULL;
+    if (file != NULL) {
+        offset = 8;
+        bool written = true;
+        for (uint32_t i = 0; i < count && written; i++) {
+            uint32_t size = readU32(batch.data() + offset + 4);
+            written = std::fseek(file, static_cast<long>(readU32(batch.data() + offset)) * PAGE_SIZE, SEEK_SET) == 0 &&
+                      writeBytes(file, std::string_view(batch).substr(offset + 8, size));
+            offset += 8 + size;
+        }
+        written = syncFile(file) && written;
+        if (std::fclose(file) != 0 || !written) {
+            return false;
+        }
+    }
+
+    std::remove(batch_path.c_str());
+    return true;
+}
+
+bool PagedFile::load(std::string_view content, std::vector<std::string_view>& records,
+                     std::vector<uint32_t>& damaged_pages) {
+    clear();
+    records.clear();
+    damaged_pages.clear();
+    if (content.size() < PAGE_SIZE || content.size() % PAGE_SIZE != 0 ||
+        std::memcmp(content.data(), magic, 4) != 0 || readU32(content.data() + 4) != VERSION ||
+        readU32(content.data() + 8) != PAGE_SIZE) {
+        return false;
+    }
+
+    uint32_t page_count = content.size() / PAGE_SIZE;
+    std::vector<uint64_t> page_sequence(page_count, 0);
+    std::vector<uint32_t> record_slot;
+    pages.assign(page_count, PageInfo{0, 0});
+
+    for (uint32_t page = 1; page < page_count; ) {
+        const char* bytes = content.data() + static_cast<std::size_t>(page) * PAGE_SIZE;
+        uint32_t count = readU32(bytes);
+        uint32_t span = readU32(bytes + 4);
+        bool damaged = (span == 0 || span > page_count - page);
+        span = damaged ? 1 : span;
+
+        page_sequence[page] = static_cast<uint64_t>(readI64(bytes + 8));
+        sequence = (page_sequence[page] > sequence) ? page_sequence[page] : sequence;
+        std::size_t limit = static_cast<std::size_t>(span) * PAGE_SIZE;
+        std::size_t offset = PAGE_HEADER_SIZE;
+
+        for (uint32_t i = 0; i < count && !damaged; i++) {
+            if (offset + ENTRY_HEADER_SIZE > limit || readU32(bytes + offset + 4) > limit - offset - ENTRY_HEADER_SIZE) {
+                damaged = true;
+                break;
+            }
+
+            unsigned int id = readU32(bytes + offset);
+            std::string_view record(bytes + offset + ENTRY_HEADER_SIZE, readU32(bytes + offset + 4));
+            offset += ENTRY_HEADER_SIZE + record.size();
+
+            uint32_t previous = findPage(id);
+            if (previous == 0) {
+                if (id >= record_slot.size()) {
+                    record_slot.resize(id + 1 + id / 2, 0);
+                }
+                records.push_back(record);
+                record_slot[id] = records.size();
+                setPage(id, page);
+            } else if (page_sequence[previous] > page_sequence[page]) {
+                stale_entries.push_back(std::make_pair(page, id));
+            } else {
+                stale_entries.push_back(std::make_pair(previous, id));
+                records[record_slot[id] - 1] = record;
+                setPage(id, page);
+            }
+        }
+
+        if (damaged) {
+            damaged_pages.push_back(page);
+        }
+        pages[page].used = offset - PAGE_HEADER_SIZE;
+        pages[page].span = span;
+        if (count == 0 && span == 1) {
+            empty_pages.push_back(page);
+        }
+        if (span == 1) {
+            fill_page = page;
+        }
+        page += span;
+    }
+
+    return true;
+}
+
+bool PagedFile::open(std::vector<std::string_view>& records, std::vector<std::string>& damaged) {
+    damaged.clear();
+    if (!recover() || !mapped.open(path)) {
+        return false;
+    }
+
+    std::vector<uint32_t> damaged_pages;
+    if (!load(mapped.view(), records, damaged_pages)) {
+        mapped.close();
+        return false;
+    }
+    for (unsigned int i = 0; i < damaged_pages.size(); i++) {
+        damaged.push_back(path + " page " + std::to_string(damaged_pages[i]));
+    }
+    return true;
+}
+
+void PagedFile::close() {
+    mapped.close();
+}
+
+bool PagedFile::commit(const std::vector<std::pair<unsigned int, std::string> >& puts,
+                       const std::vector<unsigned int>& removals) {
+    if (pages.empty()) {
+        return false;
+    }
+
+    std::FILE* file = std::fopen(path.c_str(), "r+b");
+    if (file == NULL) {
+        return false;
+    }
+
+    std::map<uint32_t, std::string> cache;
+    bool readable = true;
+    for (unsigned int i = 0; i < stale_entries.size() && readable; i++) {
+        readable = removeEntry(file, stale_entries[i].first, stale_entries[i].second, cache);
+    }
+    stale_entries.clear();
+
+    for (unsigned int i = 0; i < removals.size() && readable; i++) {
+        uint32_t page = findPage(removals[i]);
+        if (page != 0) {
+            readable = removeEntry(file, page, removals[i], cache);
+            setPage(removals[i], 0);
+        }
+    }
+
+    for (unsigned int i = 0; i < puts.size() && readable; i++) {
+        unsigned int id = puts[i].first;
+        uint32_t page = findPage(id);
+        bool placed = false;
+        if (page != 0) {
+            readable = placeEntry(file, page, id, puts[i].second, cache, placed) &&
+                       (placed || removeEntry(file, page, id, cache));
+        }
+        if (placed || !readable) {
+            continue;
+        }
+
+        page = allocatePage(ENTRY_HEADER_SIZE + puts[i].second.size(), cache);
+        std::string* bytes = loadPage(file, page, cache);
+        readable = bytes != NULL;
+        if (readable) {
+            pages[page].used = repackPage(*bytes, id, &puts[i].second);
+            setPage(id, page);
+        }
+    }
+
+    if (!readable) {
+        std::fclose(file);
+        clear();
+        return false;
+    }
+
+    sequence++;
+    std::string stamp;
+    putI64(stamp, static_cast<int64_t>(sequence));
+    std::string batch(magic, 4);
+    putU32(batch, cache.size());
+    for (std::map<uint32_t, std::string>::iterator it = cache.begin(); it != cache.end(); ++it) {
+        it->second.replace(8, 8, stamp);
+        putU32(batch, it->first);
+        putU32(batch, it->second.size());
+        batch += it->second;
+    }
+    putU32(batch, crc32(batch));
+    if (!writeFileAtomically(batch_path, batch)) {
+        std::fclose(file);
+        return false;
+    }
+
+    last_write_bytes = batch.size();
+    bool written = true;
+    for (std::map<uint32_t, std::string>::iterator it = cache.begin(); it != cache.end() && written; ++it) {
+        written = std::fseek(file, static_cast<long>(it->first) * PAGE_SIZE, SEEK_SET) == 0 &&
+                  writeBytes(file, it->second);
+        last_write_bytes += it->second.size();
+    }
+
+    written = syncFile(file) && written;
+    if (std::fclose(file) != 0 || !written) {
+        return false;
+    }
+    std::remove(batch_path.c_str());
+    return true;
+}
+
+bool PagedFile::rewrite(const std::vector<std::pair<unsigned int, std::string> >& records) {
+    AtomicFile file(path);
+    if (!file.open()) {
+        return false;
+    }
+    std::remove(batch_path.c_str());
+
+    clear();
+    sequence = 1;
+    pages.push_back(PageInfo{0, 0});
+
+    std::string stamp;
+    putI64(stamp, static_cast<int64_t>(sequence));
+    std::string header;
+    writeHeaderPage(header);
+    bool written = file.write(header);
+    last_write_bytes = header.size();
+
+    std::string page = makeEmptyPage(1);
+    uint32_t count = 0;
+    std::size_t used = 0;
+
+    for (unsigned int i = 0; i <= records.size(); i++) {
+        std::size_t entry_size = (i < records.size()) ? ENTRY_HEADER_SIZE + records[i].second.size() : 0;
+        if (count > 0 && (i == records.size() || used + entry_size > PAGE_CAPACITY)) {
+            storeU32(page, 0, count);
+            page.replace(8, 8, stamp);
+            written = written && file.write(page);
+            last_write_bytes += page.size();
+            pages.push_back(PageInfo{static_cast<uint32_t>(used), 1});
+            fill_page = pages.size() - 1;
+            page = makeEmptyPage(1);
+            count = 0;
+            used = 0;
+        }
+        if (i == records.size()) {
+            break;
+        }
+
+        if (entry_size > PAGE_CAPACITY) {
+            uint32_t span = (entry_size + PAGE_HEADER_SIZE + PAGE_SIZE - 1) / PAGE_SIZE;
+            std::string run = makeEmptyPage(span);
+            storeU32(run, 0, 1);
+            run.replace(8, 8, stamp);
+            storeU32(run, PAGE_HEADER_SIZE, records[i].first);
+            storeU32(run, PAGE_HEADER_SIZE + 4, records[i].second.size());
+            run.replace(PAGE_HEADER_SIZE + ENTRY_HEADER_SIZE, records[i].second.size(), records[i].second);
+            written = written && file.write(run);
+            last_write_bytes += run.size();
+
+            setPage(records[i].first, pages.size());
+            pages.push_back(PageInfo{static_cast<uint32_t>(entry_size), span});
+            for (uint32_t j = 1; j < span; j++) {
+                pages.push_back(PageInfo{0, 0});
+            }
+            continue;
+        }
+
+        storeU32(page, PAGE_HEADER_SIZE + used, records[i].first);
+        storeU32(page, PAGE_HEADER_SIZE + used + 4, records[i].second.size());
+        page.replace(PAGE_HEADER_SIZE + used + ENTRY_HEADER_SIZE, records[i].second.size(), records[i].second);
+        setPage(records[i].first, pages.size());
+        used += entry_size;
+        count++;
+    }
+
+    if (!written || !file.commit()) {
+        clear();
+        return false;
+    }
+    return true;
+}
+
+void PagedFile::clear() {
+    pages.clear();
+    record_pages.clear();
+    empty_pages.clear();
+    stale_entries.clear();
+    fill_page = 0;
+    sequence = 0;
+    last_write_bytes = 0;
+}
+
+std::string PagedFile::getPath() const {
+    return path;
+}
+
+std::size_t PagedFile::getLastWriteBytes() const {
+    return last_write_bytes;
+}
+
+bool PagedFile::isAttached() const {
+    return !pages.empty();
+}
+
+uint32_t PagedFile::getPageCount() const {
+    return pages.size();
+}
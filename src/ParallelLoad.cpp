@@ -0,0 +1,68 @@
+#include "ParallelLoad.hpp"
+#include "outils.hpp"
+#include <atomic>
+#include <thread>
+#include <cstdlib>
+
+unsigned int loaderThreadCount() {
+    const char* setting = std::getenv(LOAD_THREADS_VARIABLE);
+    unsigned int threads;
+    if (setting != NULL && parseUnsigned(setting, threads) && threads > 0) {
+        return threads;
+    }
+
+    threads = std::thread::hardware_concurrency();
+    return threads > 0 ? threads : 1;
+}
+
+unsigned int partCount(std::size_t work_size, std::size_t min_part_size) {
+    std::size_t parts = work_size / min_part_size;
+    unsigned int threads = loaderThreadCount();
+    if (parts < 1) {
+        return 1;
+    }
+    return parts < threads ? static_cast<unsigned int>(parts) : threads;
+}
+
+void splitAtLines(std::string_view content, unsigned int chunk_count, std::vector<std::string_view>& chunks) {
+    chunks.clear();
+    std::string_view::size_type chunk_start = 0;
+
+    for (unsigned int c = 1; c < chunk_count && chunk_start < content.size(); c++) {
+        std::string_view::size_type target = content.size() / chunk_count * c;
+        if (target < chunk_start) {
+            continue;
+        }
+        std::string_view::size_type line_end = content.find('\n', target);
+        if (line_end == std::string_view::npos) {
+            break;
+        }
+        chunks.push_back(content.substr(chunk_start, line_end + 1 - chunk_start));
+        chunk_start = line_end + 1;
+    }
+
+    if (chunk_start < content.size() || chunks.empty()) {
+        chunks.push_back(content.substr(chunk_start));
+    }
+}
+
+void runParallel(unsigned int task_count, const std::function<void(unsigned int)>& task) {
+    unsigned int thread_count = loaderThreadCount();
+    thread_count = (task_count < thread_count) ? task_count : thread_count;
+    std::atomic<unsigned int> next_task(0);
+    std::function<void()> worker = [&]() {
+        unsigned int t;
+        while ((t = next_task.fetch_add(1)) < task_count) {
+            task(t);
+        }
+    };
+
+    std::vector<std::thread> threads;
+    for (unsigned int i = 1; i < thread_count; i++) {
+        threads.push_back(std::thread(worker));
+    }
+    worker();
+    for (unsigned int i = 0; i < threads.size(); i++) {
+        threads[i].join();
+    }
+}
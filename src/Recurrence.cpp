@@ -0,0 +1,318 @@
+#include "Recurrence.hpp"
+#include "outils.hpp"
+#include <algorithm>
+
+static const char* const WEEKDAY_CODES[7] = {"MO", "TU", "WE", "TH", "FR", "SA", "SU"};
+static const char* const WEEKDAY_NAMES[7] = {"Mon", "Tue", "Wed", "Thu", "Fri", "Sat", "Sun"};
+
+long stampToDay(long stamp) {
+    return stamp >= 0 ? stamp / 1440 : (stamp - 1439) / 1440;
+}
+
+int weekdayOfDay(long day) {
+    return static_cast<int>(((day % 7) + 7 + 3) % 7);
+}
+
+static bool parseDay(std::string_view text, long& day) {
+    if (text.size() != 10) {
+        return false;
+    }
+    for (unsigned int i = 0; i < text.size(); i++) {
+        if ((i == 4 || i == 7) ? text[i] != '-' : !std::isdigit(static_cast<unsigned char>(text[i]))) {
+            return false;
+        }
+    }
+
+    day = stampToDay(toMinuteStamp(text, "00:00"));
+    return stampToDate(day * 1440) == text;
+}
+
+Recurrence::Recurrence() {
+    frequency = NONE;
+    interval = 1;
+    weekdays = 0;
+    count = 0;
+    until_day = NO_END;
+    first_day = 0;
+    period_anchor = 0;
+    last_day = NO_END;
+}
+
+bool Recurrence::parse(std::string_view rule, std::string& error) {
+    *this = Recurrence();
+    if (rule.empty()) {
+        return true;
+    }
+
+    std::string_view::size_type part_start = 0;
+    while (part_start <= rule.size()) {
+        std::string_view::size_type part_end = rule.find(';', part_start);
+        if (part_end == std::string_view::npos) {
+            part_end = rule.size();
+        }
+        std::string_view part = rule.substr(part_start, part_end - part_start);
+        part_start = part_end + 1;
+
+        std::string_view::size_type equals = part.find('=');
+        if (equals == std::string_view::npos) {
+            error = "Recurrence rule part '" + std::string(part) + "' must look like KEY=VALUE";
+            return false;
+        }
+        std::string_view key = part.substr(0, equals);
+        std::string_view value = part.substr(equals + 1);
+
+        if (key == "FREQ") {
+            if (value == "DAILY") {
+                frequency = DAILY;
+            } else if (value == "WEEKLY") {
+                frequency = WEEKLY;
+            } else {
+                error = "FREQ must be DAILY or WEEKLY";
+                return false;
+            }
+        } else if (key == "INTERVAL") {
+            if (!parseUnsigned(value, interval) || interval == 0 || interval > MAX_INTERVAL) {
+                error = "INTERVAL must be between 1 and " + std::to_string(MAX_INTERVAL);
+                return false;
+            }
+        } else if (key == "COUNT") {
+            if (!parseUnsigned(value, count) || count == 0 || count > MAX_COUNT) {
+                error = "COUNT must be between 1 and " + std::to_string(MAX_COUNT);
+                return false;
+            }
+        } else if (key == "UNTIL") {
+            if (!parseDay(value, until_day)) {
+                error = "UNTIL must be a date in YYYY-MM-DD format";
+                return false;
+            }
+        } else if (key == "BYDAY" || key == "EXDATE") {
+            std::string_view::size_type item_start = 0;
+            while (item_start <= value.size()) {
+                std::string_view::size_type item_end = value.find(',', item_start);
+                if (item_end == std::string_view::npos) {
+                    item_end = value.size();
+                }
+                std::string_view item = value.substr(item_start, item_end - item_start);
+                item_start = item_end + 1;
+
+                if (key == "EXDATE") {
+                    long day;
+                    if (!parseDay(item, day)) {
+                        error = "EXDATE entries must be dates in YYYY-MM-DD format";
+                        return false;
+                    }
+                    exceptions.push_back(day);
+                    continue;
+                }
+
+                unsigned int weekday = 0;
+                while (weekday < 7 && item != WEEKDAY_CODES[weekday]) {
+                    weekday++;
+                }
+                if (weekday == 7) {
+                    error = "BYDAY entries must be MO, TU, WE, TH, FR, SA or SU";
+                    return false;
+                }
+                weekdays |= 1u << weekday;
+            }
+        } else {
+            error = "Unknown recurrence rule part '" + std::string(key) + "'";
+            return false;
+        }
+    }
+
+    if (frequency == NONE) {
+        error = "Recurrence rule needs FREQ=DAILY or FREQ=WEEKLY";
+        return false;
+    }
+    if (frequency == DAILY && weekdays != 0) {
+        error = "BYDAY only applies to FREQ=WEEKLY";
+        return false;
+    }
+    if (count != 0 && until_day != NO_END) {
+        error = "Use either COUNT or UNTIL, not both";
+        return false;
+    }
+
+    std::sort(exceptions.begin(), exceptions.end());
+    exceptions.erase(std::unique(exceptions.begin(), exceptions.end()), exceptions.end());
+    return true;
+}
+
+bool Recurrence::anchor(long first_day, std::string& error) {
+    if (frequency == NONE) {
+        return true;
+    }
+
+    int first_weekday = weekdayOfDay(first_day);
+    if (frequency == WEEKLY && weekdays == 0) {
+        weekdays = 1u << first_weekday;
+    }
+    if (frequency == WEEKLY && (weekdays & (1u << first_weekday)) == 0) {
+        error = "The first date is a " + std::string(WEEKDAY_NAMES[first_weekday]) +
+                ", which is not one of the BYDAY days";
+        return false;
+    }
+    if (until_day < first_day) {
+        error = "UNTIL is before the first date";
+        return false;
+    }
+
+    this->first_day = first_day;
+    day_offsets.clear();
+    if (frequency == DAILY) {
+        period_anchor = first_day;
+        day_offsets.push_back(0);
+    } else {
+        period_anchor = first_day - first_weekday;
+        for (int offset = 0; offset < 7; offset++) {
+            if (weekdays & (1u << offset)) {
+                day_offsets.push_back(offset);
+            }
+        }
+    }
+
+    last_day = until_day;
+    if (count != 0) {
+        std::vector<int>::const_iterator first_offset =
+            std::lower_bound(day_offsets.begin(), day_offsets.end(), static_cast<int>(first_day - period_anchor));
+        long last_index = (first_offset - day_offsets.begin()) + count - 1;
+        long period_index = last_index / day_offsets.size();
+        last_day = period_anchor + period_index * getPeriodDays() + day_offsets[last_index % day_offsets.size()];
+    }
+    return true;
+}
+
+bool Recurrence::addException(long day) {
+    if (!occursOn(day)) {
+        return false;
+    }
+    exceptions.insert(std::upper_bound(exceptions.begin(), exceptions.end(), day), day);
+    return true;
+}
+
+bool Recurrence::isRecurring() const {
+    return frequency != NONE;
+}
+
+bool Recurrence::occursOn(long day) const {
+    if (frequency == NONE) {
+        return day == first_day;
+    }
+    if (day < first_day || day > last_day) {
+        return false;
+    }
+
+    int offset = static_cast<int>((day - period_anchor) % getPeriodDays());
+    return std::binary_search(day_offsets.begin(), day_offsets.end(), offset) &&
+           !std::binary_search(exceptions.begin(), exceptions.end(), day);
+}
+
+long Recurrence::nextOn(long day) const {
+    if (frequency == NONE) {
+        return day <= first_day ? first_day : NO_END;
+    }
+
+    long period = getPeriodDays();
+    while (true) {
+        if (day < first_day) {
+            day = first_day;
+        }
+
+        long period_start = period_anchor + (day - period_anchor) / period * period;
+        std::vector<int>::const_iterator offset =
+            std::lower_bound(day_offsets.begin(), day_offsets.end(), static_cast<int>(day - period_start));
+        long candidate = (offset != day_offsets.end()) ? period_start + *offset
+                                                       : period_start + period + day_offsets[0];
+        if (candidate > last_day) {
+            return NO_END;
+        }
+        if (!std::binary_search(exceptions.begin(), exceptions.end(), candidate)) {
+            return candidate;
+        }
+        day = candidate + 1;
+    }
+}
+
+long Recurrence::getFirstDay() const {
+    return first_day;
+}
+
+long Recurrence::getLastDay() const {
+    return frequency == NONE ? first_day : last_day;
+}
+
+long Recurrence::getSettledDay() const {
+    if (exceptions.empty() || exceptions.back() < first_day) {
+        return first_day;
+    }
+    return exceptions.back();
+}
+
+long Recurrence::getPeriodDays() const {
+    return frequency == WEEKLY ? 7L * interval : interval;
+}
+
+unsigned int Recurrence::getExceptionCount() const {
+    return exceptions.size();
+}
+
+std::string Recurrence::toString() const {
+    if (frequency == NONE) {
+        return "";
+    }
+
+    std::string rule = frequency == DAILY ? "FREQ=DAILY" : "FREQ=WEEKLY";
+    if (interval != 1) {
+        rule += ";INTERVAL=" + std::to_string(interval);
+    }
+    if (weekdays != 0) {
+        rule += ";BYDAY=";
+        for (unsigned int i = 0, written = 0; i < 7; i++) {
+            if (weekdays & (1u << i)) {
+                rule += (written++ > 0 ? "," : "");
+                rule += WEEKDAY_CODES[i];
+            }
+        }
+    }
+    if (count != 0) {
+        rule += ";COUNT=" + std::to_string(count);
+    }
+    if (until_day != NO_END) {
+        rule += ";UNTIL=" + stampToDate(until_day * 1440);
+    }
+    for (unsigned int i = 0; i < exceptions.size(); i++) {
+        rule += (i == 0 ? ";EXDATE=" : ",");
+        rule += stampToDate(exceptions[i] * 1440);
+    }
+    return rule;
+}
+
+std::string Recurrence::describe() const {
+    if (frequency == NONE) {
+        return "Does not repeat";
+    }
+
+    std::string text;
+    if (frequency == DAILY) {
+        text = interval == 1 ? "Daily" : "Every " + std::to_string(interval) + " days";
+    } else {
+        text = interval == 1 ? "Weekly on " : "Every " + std::to_string(interval) + " weeks on ";
+        for (unsigned int i = 0, written = 0; i < 7; i++) {
+            if (weekdays & (1u << i)) {
+                text += (written++ > 0 ? ", " : "");
+                text += WEEKDAY_NAMES[i];
+            }
+        }
+    }
+
+    if (count != 0) {
+        text += ", " + std::to_string(count) + " times";
+    } else if (until_day != NO_END) {
+        text += ", until " + stampToDate(until_day * 1440);
+    }
+    if (!exceptions.empty()) {
+        text += ", " + std::to_string(exceptions.size()) + " skipped";
+    }
+    return text;
+}
@@ -15,18 +15,15 @@ Resource::Resource(unsigned int id, const std::string& name, const std::string&
     this->is_available = available;
 }
 
-Resource::~Resource() {
-}
-
 unsigned int Resource::getId() const {
     return id;
 }
 
-std::string Resource::getName() const {
+const std::string& Resource::getName() const {
     return name;
 }
 
-std::string Resource::getType() const {
+const std::string& Resource::getType() const {
     return type;
 }
 
@@ -0,0 +1,105 @@
+#include "ResourceCodec.hpp"
+#include "BinarySnapshot.hpp"
+#include "outils.hpp"
+#include <algorithm>
+
+static const char RESOURCE_SNAPSHOT_MAGIC[4] = {'C', 'R', 'M', 'R'};
+static const std::size_t RESOURCE_RECORD_SIZE = 16;
+
+ResourceCodec::ResourceCodec() {
+    table.name = "resources";
+    table.columns.push_back(SqliteColumn{"name", "TEXT NOT NULL", true});
+    table.columns.push_back(SqliteColumn{"type", "TEXT NOT NULL", true});
+    table.columns.push_back(SqliteColumn{"available", "INTEGER NOT NULL", false});
+}
+
+std::string ResourceCodec::toLine(const Resource& resource) const {
+    return resource.toString();
+}
+
+bool ResourceCodec::parseLine(std::string_view line, Resource& resource) const {
+    std::string_view parts[4];
+    if (splitFields(line, '|', parts, 4) != 4) {
+        return false;
+    }
+    
+    unsigned int id;
+    if (!parseUnsigned(parts[0], id)) {
+        return false;
+    }
+    
+    resource = Resource(id, std::string(parts[1]), std::string(parts[2]), parts[3] == "1");
+    return true;
+}
+
+void ResourceCodec::writeSnapshot(const std::vector<const Resource*>& resources, std::string& content) const {
+    StringTableBuilder strings;
+    std::string records;
+    records.reserve(resources.size() * RESOURCE_RECORD_SIZE);
+    
+    for (unsigned int i = 0; i < resources.size(); i++) {
+        putU32(records, resources[i]->getId());
+        putU32(records, strings.intern(resources[i]->getName()));
+        putU32(records, strings.intern(resources[i]->getType()));
+        putU32(records, resources[i]->isAvailable() ? 1 : 0);
+    }
+    
+    SnapshotHeader header;
+    std::copy(RESOURCE_SNAPSHOT_MAGIC, RESOURCE_SNAPSHOT_MAGIC + 4, header.magic);
+    header.version = SNAPSHOT_VERSION;
+    header.record_count = resources.size();
+    header.id_count = 0;
+    header.string_count = strings.getCount();
+    header.string_bytes = strings.getByteSize();
+    
+    content.clear();
+    content.reserve(SNAPSHOT_HEADER_SIZE + records.size() + (header.string_count + 1) * 4 + header.string_bytes);
+    writeSnapshotHeader(content, header);
+    content += records;
+    strings.appendTo(content);
+}
+
+bool ResourceCodec::readSnapshot(std::string_view content, std::vector<Resource>& resources) const {
+    SnapshotHeader header;
+    if (!readSnapshotHeader(content, RESOURCE_SNAPSHOT_MAGIC, SNAPSHOT_VERSION, header) || header.id_count != 0) {
+        return false;
+    }
+    
+    std::size_t records_size = static_cast<std::size_t>(header.record_count) * RESOURCE_RECORD_SIZE;
+    if (content.size() < SNAPSHOT_HEADER_SIZE + records_size) {
+        return false;
+    }
+    
+    StringTableView strings;
+    if (!strings.attach(content.substr(SNAPSHOT_HEADER_SIZE + records_size), header.string_count, header.string_bytes)) {
+        return false;
+    }
+    
+    resources.reserve(header.record_count);
+    const char* record = content.data() + SNAPSHOT_HEADER_SIZE;
+    
+    for (unsigned int i = 0; i < header.record_count; i++, record += RESOURCE_RECORD_SIZE) {
+        std::string_view name, type;
+        if (!strings.get(readU32(record + 4), name) || !strings.get(readU32(record + 8), type)) {
+            return false;
+        }
+        resources.push_back(Resource(readU32(record), std::string(name), std::string(type), readU32(record + 12) != 0));
+    }
+    return true;
+}
+
+const SqliteTable& ResourceCodec::getSqliteTable() const {
+    return table;
+}
+
+void ResourceCodec::writeRow(const Resource& resource, SqliteRow& row) const {
+    row.setId(resource.getId());
+    row.setText(0, resource.getName());
+    row.setText(1, resource.getType());
+    row.setInteger(2, resource.isAvailable() ? 1 : 0);
+}
+
+bool ResourceCodec::readRow(const SqliteRow& row, Resource& resource) const {
+    resource = Resource(row.getId(), std::string(row.getText(0)), std::string(row.getText(1)), row.getInteger(2) != 0);
+    return true;
+}
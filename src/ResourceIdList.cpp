@@ -0,0 +1,147 @@
+#include "ResourceIdList.hpp"
+#include <cstring>
+
+ResourceIdList::ResourceIdList() : count(0), capacity(INLINE_CAPACITY) {
+}
+
+ResourceIdList::ResourceIdList(const std::vector<unsigned int>& ids) : count(0), capacity(INLINE_CAPACITY) {
+    assign(ids.data(), ids.size());
+}
+
+ResourceIdList::ResourceIdList(const ResourceIdList& other) : count(0), capacity(INLINE_CAPACITY) {
+    assign(other.data(), other.count);
+}
+
+ResourceIdList::ResourceIdList(ResourceIdList&& other) noexcept : count(other.count), capacity(other.capacity) {
+    if (other.isInline()) {
+        std::memcpy(inline_ids, other.inline_ids, sizeof(inline_ids));
+    } else {
+        heap_ids = other.heap_ids;
+        other.capacity = INLINE_CAPACITY;
+    }
+    other.count = 0;
+}
+
+ResourceIdList& ResourceIdList::operator=(const ResourceIdList& other) {
+    if (this != &other) {
+        count = 0;
+        assign(other.data(), other.count);
+    }
+    return *this;
+}
+
+ResourceIdList& ResourceIdList::operator=(ResourceIdList&& other) noexcept {
+    if (this != &other) {
+        release();
+        count = other.count;
+        capacity = other.capacity;
+        if (other.isInline()) {
+            std::memcpy(inline_ids, other.inline_ids, sizeof(inline_ids));
+        } else {
+            heap_ids = other.heap_ids;
+            other.capacity = INLINE_CAPACITY;
+        }
+        other.count = 0;
+    }
+    return *this;
+}
+
+ResourceIdList::~ResourceIdList() {
+    release();
+}
+
+bool ResourceIdList::isInline() const {
+    return capacity == INLINE_CAPACITY;
+}
+
+void ResourceIdList::assign(const unsigned int* ids, uint32_t id_count) {
+    if (id_count > capacity) {
+        grow(id_count);
+    }
+    if (id_count > 0) {
+        std::memcpy(isInline() ? inline_ids : heap_ids, ids, id_count * sizeof(unsigned int));
+    }
+    count = id_count;
+}
+
+void ResourceIdList::release() {
+    if (!isInline()) {
+        delete[] heap_ids;
+        capacity = INLINE_CAPACITY;
+    }
+    count = 0;
+}
+
+void ResourceIdList::grow(uint32_t min_capacity) {
+    uint32_t new_capacity = capacity * 2;
+    if (new_capacity < min_capacity) {
+        new_capacity = min_capacity;
+    }
+
+    unsigned int* grown = new unsigned int[new_capacity];
+    if (count > 0) {
+        std::memcpy(grown, data(), count * sizeof(unsigned int));
+    }
+    if (!isInline()) {
+        delete[] heap_ids;
+    }
+    heap_ids = grown;
+    capacity = new_capacity;
+}
+
+unsigned int ResourceIdList::size() const {
+    return count;
+}
+
+bool ResourceIdList::empty() const {
+    return count == 0;
+}
+
+unsigned int ResourceIdList::operator[](unsigned int index) const {
+    return data()[index];
+}
+
+const unsigned int* ResourceIdList::data() const {
+    return isInline() ? inline_ids : heap_ids;
+}
+
+const unsigned int* ResourceIdList::begin() const {
+    return data();
+}
+
+const unsigned int* ResourceIdList::end() const {
+    return data() + count;
+}
+
+bool ResourceIdList::contains(unsigned int id) const {
+    const unsigned int* ids = data();
+    for (unsigned int i = 0; i < count; i++) {
+        if (ids[i] == id) {
+            return true;
+        }
+    }
+    return false;
+}
+
+std::vector<unsigned int> ResourceIdList::toVector() const {
+    return std::vector<unsigned int>(begin(), end());
+}
+
+void ResourceIdList::push_back(unsigned int id) {
+    if (count == capacity) {
+        grow(count + 1);
+    }
+    (isInline() ? inline_ids : heap_ids)[count++] = id;
+}
+
+void ResourceIdList::erase(unsigned int index) {
+    unsigned int* ids = isInline() ? inline_ids : heap_ids;
+    for (unsigned int i = index + 1; i < count; i++) {
+        ids[i - 1] = ids[i];
+    }
+    count--;
+}
+
+void ResourceIdList::clear() {
+    count = 0;
+}
@@ -1,24 +1,221 @@
 #include "ResourceManager.hpp"
+#include "DurableFile.hpp"
+#include "MappedFile.hpp"
+#include "CsvImport.hpp"
 #include <iostream>
+#include <cstdio>
+#include <algorithm>
+#include <thread>
 
-ResourceManager::ResourceManager() {
-    data_file = "data/resources.txt";
+static const unsigned int MIN_JOURNAL_ENTRIES_BEFORE_COMPACTION = 1024;
+static const char RESOURCE_PAGES_MAGIC[4] = {'C', 'R', 'P', 'R'};
+static const unsigned int MAX_SUGGESTIONS = 5;
+
+ResourceManager::ResourceManager()
+    : journal("data/resources.log"),
+      text_store("data/resources.txt", codec),
+      binary_store("data/resources.bin", codec),
+      paged_store("data/resources.pages", RESOURCE_PAGES_MAGIC, codec),
+      sqlite_store("data/resources.db", codec) {
+    stores[TEXT_STORAGE] = &text_store;
+    stores[BINARY_STORAGE] = &binary_store;
+    stores[PAGED_STORAGE] = &paged_store;
+    stores[SQLITE_STORAGE] = &sqlite_store;
+    backend = &text_store;
+    quarantine_file = "data/resources.quarantine";
+    auto_save = true;
     next_id = 1;
+    damaged_count = 0;
 }
 
 ResourceManager::~ResourceManager() {
 }
 
+bool ResourceManager::isValidText(const std::string& text) const {
+    return !text.empty() && text.find('|') == std::string::npos && text.find('\n') == std::string::npos;
+}
+
+unsigned int ResourceManager::createResource(const std::string& name, const std::string& type,
+                                             bool is_available, std::string& error) {
+    std::unique_lock<std::shared_mutex> lock(mutex);
+    if (!isValidText(name)) {
+        error = "Resource name cannot be empty or contain '|'!";
+        return 0;
+    }
+    if (!isValidText(type)) {
+        error = "Resource type cannot be empty or contain '|'!";
+        return 0;
+    }
+    
+    Resource resource(next_id, name, type, is_available);
+    if (!journalChange(Journal::PUT, resource.toString(), error)) {
+        return 0;
+    }
+    
+    SlabHandle handle = resources.insert(std::move(resource));
+    indexResource(handle.slot);
+    indexSearchTerms(resources[handle.slot]);
+    recordChange(next_id);
+    return next_id++;
+}
+
+bool ResourceManager::importFromCsv(const std::string& path, ImportReport& report, std::string& error) {
+    std::unique_lock<std::shared_mutex> lock(mutex);
+    MappedFile file;
+    if (!file.open(path)) {
+        error = "Cannot open " + path;
+        return false;
+    }
+    
+    std::string_view content = file.view();
+    std::vector<std::string> fields;
+    std::string_view::size_type line_start = 0;
+    unsigned int line_number = 0;
+    std::vector<Resource> imported;
+    
+    while (line_start < content.size()) {
+        std::string_view::size_type line_end = content.find('\n', line_start);
+        if (line_end == std::string_view::npos) {
+            line_end = content.size();
+        }
+        std::string_view line = content.substr(line_start, line_end - line_start);
+        line_start = line_end + 1;
+        line_number++;
+        
+        if (line.empty() || line == "\r") {
+            continue;
+        }
+        if (!parseCsvLine(line, fields)) {
+            report.reject(line_number, "Unterminated quoted field");
+            continue;
+        }
+        if (line_number == 1 && isCsvHeader(fields, "name")) {
+            continue;
+        }
+        if (fields.size() < 2 || fields.size() > 3) {
+            report.reject(line_number, "Expected name,type[,available]");
+            continue;
+        }
+        
+        bool is_available = true;
+        if (fields.size() == 3 && !parseCsvBool(fields[2], is_available)) {
+            report.reject(line_number, "Invalid availability '" + fields[2] + "'");
+            continue;
+        }
+        if (!isValidText(fields[0]) || !isValidText(fields[1])) {
+            report.reject(line_number, "Resource name and type cannot be empty or contain '|'");
+            continue;
+        }
+        
+        imported.push_back(Resource(next_id + imported.size(), fields[0], fields[1], is_available));
+    }
+    
+    std::vector<std::string> payloads;
+    payloads.reserve(imported.size());
+    for (unsigned int i = 0; i < imported.size(); i++) {
+        payloads.push_back(imported[i].toString());
+    }
+    if (!imported.empty() && !journalChange(Journal::PUT, payloads, error)) {
+        return false;
+    }
+    
+    for (unsigned int i = 0; i < imported.size(); i++) {
+        SlabHandle handle = resources.insert(std::move(imported[i]));
+        indexResource(handle.slot);
+        indexSearchTerms(resources[handle.slot]);
+        markDirty(resources[handle.slot].getId());
+    }
+    next_id += imported.size();
+    report.imported = imported.size();
+    compactLargeJournal();
+    return true;
+}
+
+bool ResourceManager::modifyResource(unsigned int id, const std::string& new_name, const std::string& new_type,
+                                     int new_availability, bool can_change_availability, std::string& error) {
+    std::unique_lock<std::shared_mutex> lock(mutex);
+    std::unordered_map<unsigned int, unsigned int>::const_iterator it = id_index.find(id);
+    if (it == id_index.end()) {
+        error = "Resource with ID " + std::to_string(id) + " not found.";
+        return false;
+    }
+    unsigned int slot = it->second;
+    Resource* resource = &resources[slot];
+    if (!new_name.empty() && !isValidText(new_name)) {
+        error = "Resource name cannot contain '|'!";
+        return false;
+    }
+    if (!new_type.empty() && !isValidText(new_type)) {
+        error = "Resource type cannot contain '|'!";
+        return false;
+    }
+    if (new_availability == 0 && resource->isAvailable() && !can_change_availability) {
+        error = "Cannot set resource to unavailable because it is currently used by one or more events.";
+        return false;
+    }
+    
+    Resource updated = *resource;
+    if (!new_type.empty()) {
+        updated.setType(new_type);
+    }
+    if (new_availability >= 0) {
+        updated.setAvailability(new_availability == 1);
+    }
+    bool renamed = !new_name.empty() && new_name != resource->getName();
+    if (renamed) {
+        updated.setName(new_name);
+    }
+    if (!journalChange(Journal::PUT, updated.toString(), error)) {
+        return false;
+    }
+    
+    unindexSearchTerms(*resource);
+    if (renamed) {
+        unindexResource(slot);
+    }
+    *resource = updated;
+    if (renamed) {
+        indexResource(slot);
+    }
+    indexSearchTerms(*resource);
+    
+    recordChange(id);
+    return true;
+}
+
+bool ResourceManager::removeResource(unsigned int id, std::string& error) {
+    std::unique_lock<std::shared_mutex> lock(mutex);
+    std::unordered_map<unsigned int, unsigned int>::const_iterator it = id_index.find(id);
+    if (it == id_index.end()) {
+        error = "Resource with ID " + std::to_string(id) + " not found.";
+        return false;
+    }
+    if (!journalChange(Journal::REMOVE, std::to_string(id), error)) {
+        return false;
+    }
+    
+    unsigned int slot = it->second;
+    unindexSearchTerms(resources[slot]);
+    unindexResource(slot);
+    resources.erase(slot);
+    recordChange(id);
+    return true;
+}
+
 void ResourceManager::addResource(const std::string& name, const std::string& type, bool is_available) {
-    Resource new_resource(next_id, name, type, is_available);
-    resources.push_back(new_resource);
-    std::cout << "Resource '" << name << "' added successfully with ID: " << next_id << std::endl;
+    std::string error;
+    unsigned int id = createResource(name, type, is_available, error);
+    if (id == 0) {
+        std::cout << "Error: " << error << std::endl;
+        return;
+    }
+    
+    std::cout << "Resource '" << name << "' added successfully with ID: " << id << std::endl;
     std::cout << "Status: " << (is_available ? "Available" : "Not Available") << std::endl;
-    next_id++;
-    saveToFile();
 }
 
 void ResourceManager::viewAllResources() const {
+    std::shared_lock<std::shared_mutex> lock(mutex);
     if (resources.empty()) {
         std::cout << "\n=== NO RESOURCES FOUND ===" << std::endl;
         std::cout << "No resources have been added to the system yet." << std::endl;
@@ -30,8 +227,17 @@ void ResourceManager::viewAllResources() const {
     std::cout << "Total Resources: " << resources.size() << std::endl;
     std::cout << std::endl;
     
-    for (unsigned int i = 0; i < resources.size(); i++) {
-        resources[i].displayInfo();
+    std::vector<const Resource*> ordered;
+    ordered.reserve(resources.size());
+    for (SlabStore<Resource>::const_iterator it = resources.begin(); it != resources.end(); ++it) {
+        ordered.push_back(&*it);
+    }
+    std::sort(ordered.begin(), ordered.end(), [](const Resource* a, const Resource* b) {
+        return a->getId() < b->getId();
+    });
+    
+    for (unsigned int i = 0; i < ordered.size(); i++) {
+        ordered[i]->displayInfo();
         std::cout << std::endl;
     }
 }
@@ -51,39 +257,34 @@ void ResourceManager::updateResource(unsigned int id, bool can_change_availabili
     std::cout << "New name (current: " << resource->getName() << "): ";
     std::string new_name;
     std::getline(std::cin, new_name);
-    if (!new_name.empty()) {
-        resource->setName(new_name);
-    }
     
     std::cout << "New type (current: " << resource->getType() << "): ";
     std::string new_type;
     std::getline(std::cin, new_type);
-    if (!new_type.empty()) {
-        resource->setType(new_type);
-    }
     
     std::cout << "Change availability status? (y/N): ";
     std::string change_status;
     std::getline(std::cin, change_status);
     
+    int new_availability = -1;
     if (change_status == "y" || change_status == "Y") {
         std::cout << "Set as available? (y/n): ";
         std::string availability_input;
         std::getline(std::cin, availability_input);
         
-        bool new_availability = (availability_input == "y" || availability_input == "Y");
-        
-        if (!new_availability && resource->isAvailable() && !can_change_availability) {
-            std::cout << "Error: Cannot set resource to unavailable because it is currently used by one or more events." << std::endl;
+        new_availability = (availability_input == "y" || availability_input == "Y") ? 1 : 0;
+    }
+    
+    std::string error;
+    if (!modifyResource(id, new_name, new_type, new_availability, can_change_availability, error)) {
+        std::cout << "Error: " << error << std::endl;
+        if (new_availability == 0 && !can_change_availability) {
             std::cout << "Please delete the events or update them to not use this resource first." << std::endl;
-            return;
         }
-        
-        resource->setAvailability(new_availability);
+        return;
     }
     
     std::cout << "Resource updated successfully!" << std::endl;
-    saveToFile();
 }
 
 void ResourceManager::updateResourceByName(const std::string& name, bool can_change_availability) {
@@ -96,17 +297,19 @@ void ResourceManager::updateResourceByName(const std::string& name, bool can_cha
 }
 
 void ResourceManager::deleteResource(unsigned int id) {
-    for (unsigned int i = 0; i < resources.size(); i++) {
-        if (resources[i].getId() == id) {
-            std::string resource_name = resources[i].getName();
-            std::cout << "Deleting resource: " << resource_name << " (ID: " << id << ")" << std::endl;
-            resources.erase(resources.begin() + i);
-            std::cout << "Resource deleted successfully." << std::endl;
-            saveToFile();
-            return;
-        }
+    std::unordered_map<unsigned int, unsigned int>::const_iterator it = id_index.find(id);
+    if (it == id_index.end()) {
+        std::cout << "Error: Resource with ID " << id << " not found." << std::endl;
+        return;
     }
-    std::cout << "Error: Resource with ID " << id << " not found." << std::endl;
+    
+    std::cout << "Deleting resource: " << resources[it->second].getName() << " (ID: " << id << ")" << std::endl;
+    std::string error;
+    if (!removeResource(id, error)) {
+        std::cout << "Error: " << error << std::endl;
+        return;
+    }
+    std::cout << "Resource deleted successfully." << std::endl;
 }
 
 void ResourceManager::deleteResourceByName(const std::string& name) {
@@ -130,98 +333,400 @@ std::string ResourceManager::toLowercase(const std::string& str) const {
 }
 
 int ResourceManager::getResourceCount() const {
+    std::shared_lock<std::shared_mutex> lock(mutex);
     return resources.size();
 }
 
-bool ResourceManager::resourceExists(unsigned int id) const {
-    for (unsigned int i = 0; i < resources.size(); i++) {
-        if (resources[i].getId() == id) {
-            return true;
+void ResourceManager::indexResource(unsigned int slot) {
+    id_index[resources[slot].getId()] = slot;
+    name_index.insert(std::make_pair(resources[slot].getName(), slot));
+}
+
+void ResourceManager::unindexResource(unsigned int slot) {
+    id_index.erase(resources[slot].getId());
+    std::pair<std::unordered_multimap<std::string, unsigned int, CaseInsensitiveHash, CaseInsensitiveEqual>::iterator,
+              std::unordered_multimap<std::string, unsigned int, CaseInsensitiveHash, CaseInsensitiveEqual>::iterator>
+        range = name_index.equal_range(resources[slot].getName());
+    for (std::unordered_multimap<std::string, unsigned int, CaseInsensitiveHash, CaseInsensitiveEqual>::iterator it =
+             range.first; it != range.second; ++it) {
+        if (it->second == slot) {
+            name_index.erase(it);
+            return;
         }
     }
-    return false;
 }
 
-bool ResourceManager::resourceExistsByName(const std::string& name) const {
-    std::string search_lower = toLowercase(name);
-    for (unsigned int i = 0; i < resources.size(); i++) {
-        if (toLowercase(resources[i].getName()) == search_lower) {
-            return true;
+bool ResourceManager::findNameSlot(const std::string& name, unsigned int& slot) const {
+    std::pair<std::unordered_multimap<std::string, unsigned int, CaseInsensitiveHash, CaseInsensitiveEqual>::const_iterator,
+              std::unordered_multimap<std::string, unsigned int, CaseInsensitiveHash, CaseInsensitiveEqual>::const_iterator>
+        range = name_index.equal_range(name);
+    if (range.first == range.second) {
+        return false;
+    }
+    
+    slot = range.first->second;
+    for (std::unordered_multimap<std::string, unsigned int, CaseInsensitiveHash, CaseInsensitiveEqual>::const_iterator it =
+             range.first; it != range.second; ++it) {
+        if (resources[it->second].getId() < resources[slot].getId()) {
+            slot = it->second;
         }
     }
-    return false;
+    return true;
 }
 
-Resource* ResourceManager::findResource(unsigned int id) {
-    for (unsigned int i = 0; i < resources.size(); i++) {
-        if (resources[i].getId() == id) {
-            return &resources[i];
+void ResourceManager::rebuildIndexes() {
+    std::thread name_builder([this]() {
+        name_index.clear();
+        name_index.reserve(resources.size());
+        for (SlabStore<Resource>::const_iterator it = resources.begin(); it != resources.end(); ++it) {
+            name_index.insert(std::make_pair(it->getName(), it.getSlot()));
         }
+    });
+    
+    id_index.clear();
+    id_index.reserve(resources.size());
+    for (SlabStore<Resource>::const_iterator it = resources.begin(); it != resources.end(); ++it) {
+        id_index[it->getId()] = it.getSlot();
     }
-    return NULL;
+    name_builder.join();
 }
 
-Resource* ResourceManager::findResourceByName(const std::string& name) {
-    std::string search_lower = toLowercase(name);
-    for (unsigned int i = 0; i < resources.size(); i++) {
-        if (toLowercase(resources[i].getName()) == search_lower) {
-            return &resources[i];
+void ResourceManager::indexSearchTerms(const Resource& resource) {
+    name_trigrams.add(resource.getId(), resource.getName());
+    type_trigrams.add(resource.getId(), resource.getType());
+}
+
+void ResourceManager::unindexSearchTerms(const Resource& resource) {
+    name_trigrams.remove(resource.getId(), resource.getName());
+    type_trigrams.remove(resource.getId(), resource.getType());
+}
+
+void ResourceManager::rebuildSearchIndex() {
+    std::vector<std::pair<unsigned int, std::string_view> > names;
+    std::vector<std::pair<unsigned int, std::string_view> > types;
+    names.reserve(resources.size());
+    types.reserve(resources.size());
+    for (SlabStore<Resource>::const_iterator it = resources.begin(); it != resources.end(); ++it) {
+        names.push_back(std::make_pair(it->getId(), std::string_view(it->getName())));
+        types.push_back(std::make_pair(it->getId(), std::string_view(it->getType())));
+    }
+    
+    name_trigrams.clear();
+    type_trigrams.clear();
+    name_trigrams.addAll(names);
+    type_trigrams.addAll(types);
+}
+
+std::vector<unsigned int> ResourceManager::matchText(const TrigramIndex& trigrams, const std::string& term,
+                                                     const std::string& (Resource::*field)() const) const {
+    std::vector<unsigned int> matches;
+    std::string search_lower = toLowercase(term);
+    
+    if (trigrams.findCandidates(search_lower, matches)) {
+        if (search_lower.length() == TrigramIndex::TRIGRAM_LENGTH) {
+            return matches;
+        }
+        std::vector<unsigned int>::size_type kept = 0;
+        for (unsigned int i = 0; i < matches.size(); i++) {
+            const Resource& resource = resources[id_index.find(matches[i])->second];
+            if (containsIgnoreCase((resource.*field)(), search_lower)) {
+                matches[kept++] = matches[i];
+            }
+        }
+        matches.resize(kept);
+        return matches;
+    }
+    
+    for (SlabStore<Resource>::const_iterator it = resources.begin(); it != resources.end(); ++it) {
+        if (containsIgnoreCase(((*it).*field)(), search_lower)) {
+            matches.push_back(it->getId());
         }
     }
-    return NULL;
+    return matches;
 }
 
-void ResourceManager::saveToFile() const {
-    std::ofstream file(data_file);
+std::vector<FuzzyMatch> ResourceManager::fuzzyMatchResourcesByName(const std::string& name,
+                                                                   unsigned int max_results) const {
+    std::shared_lock<std::shared_mutex> lock(mutex);
+    std::string search_lower = toLowercase(name);
+    std::vector<unsigned int> candidates;
+    int max_distance = name_trigrams.findSimilarCandidates(search_lower, candidates);
     
-    if (!file.is_open()) {
-        return;
+    if (max_distance == 0) {
+        candidates = matchText(name_trigrams, name, &Resource::getName);
     }
     
-    for (unsigned int i = 0; i < resources.size(); i++) {
-        file << resources[i].toString() << std::endl;
+    FuzzyRanker ranker(search_lower, max_distance, max_results);
+    for (unsigned int i = 0; i < candidates.size(); i++) {
+        ranker.consider(candidates[i], resources[id_index.find(candidates[i])->second].getName());
+    }
+    return ranker.finish();
+}
+
+bool ResourceManager::resourceExists(unsigned int id) const {
+    std::shared_lock<std::shared_mutex> lock(mutex);
+    return id_index.find(id) != id_index.end();
+}
+
+bool ResourceManager::resourceExistsByName(const std::string& name) const {
+    std::shared_lock<std::shared_mutex> lock(mutex);
+    return name_index.find(name) != name_index.end();
+}
+
+Resource* ResourceManager::findResource(unsigned int id) {
+    std::unordered_map<unsigned int, unsigned int>::const_iterator it = id_index.find(id);
+    if (it == id_index.end()) {
+        return NULL;
+    }
+    return &resources[it->second];
+}
+
+Resource* ResourceManager::findResourceByName(const std::string& name) {
+    unsigned int slot;
+    if (!findNameSlot(name, slot)) {
+        return NULL;
+    }
+    return &resources[slot];
+}
+
+void ResourceManager::setAutoSave(bool enabled) {
+    std::unique_lock<std::shared_mutex> lock(mutex);
+    auto_save = enabled;
+}
+
+bool ResourceManager::journalChange(char operation, const std::string& payload, std::string& error) {
+    return journalChange(operation, std::vector<std::string>(1, payload), error);
+}
+
+bool ResourceManager::journalChange(char operation, const std::vector<std::string>& payloads, std::string& error) {
+    if (!auto_save || journal.append(operation, payloads)) {
+        return true;
+    }
+    error = "Could not save the change to " + journal.getLogFile() + ", so nothing was changed.";
+    return false;
+}
+
+void ResourceManager::recordChange(unsigned int id) {
+    markDirty(id);
+    compactLargeJournal();
+}
+
+void ResourceManager::compactLargeJournal() {
+    if (auto_save && journal.getEntryCount() >= MIN_JOURNAL_ENTRIES_BEFORE_COMPACTION &&
+        journal.getEntryCount() >= resources.size()) {
+        std::string error;
+        compactJournal(error);
+    }
+}
+
+void ResourceManager::markDirty(unsigned int id) {
+    dirty_ids.insert(id);
+}
+
+bool ResourceManager::hasUnsavedChanges() const {
+    std::shared_lock<std::shared_mutex> lock(mutex);
+    return !dirty_ids.empty() || journal.getEntryCount() > 0;
+}
+
+bool ResourceManager::compactJournal(std::string& error) {
+    if (!backend->canCommitChanges()) {
+        return writeStore(*backend, error);
+    }
+    
+    std::vector<unsigned int> changed(dirty_ids.begin(), dirty_ids.end());
+    std::sort(changed.begin(), changed.end());
+    std::vector<const Resource*> puts;
+    std::vector<unsigned int> removals;
+    
+    for (unsigned int i = 0; i < changed.size(); i++) {
+        std::unordered_map<unsigned int, unsigned int>::const_iterator it = id_index.find(changed[i]);
+        if (it != id_index.end()) {
+            puts.push_back(&resources[it->second]);
+        } else {
+            removals.push_back(changed[i]);
+        }
     }
     
-    file.close();
+    if (!backend->commit(puts, removals)) {
+        return writeStore(*backend, error);
+    }
+    return clearJournal(error);
+}
+
+bool ResourceManager::save(std::string& error) {
+    std::unique_lock<std::shared_mutex> lock(mutex);
+    return compactJournal(error);
+}
+
+bool ResourceManager::saveAs(StorageFormat format, std::string& error) {
+    std::unique_lock<std::shared_mutex> lock(mutex);
+    if (stores[format] == backend) {
+        return compactJournal(error);
+    }
+    return writeStore(*stores[format], error);
+}
+
+bool ResourceManager::flushChanges(std::string& error) {
+    std::unique_lock<std::shared_mutex> lock(mutex);
+    if (backend->canCommitChanges() && auto_save && !dirty_ids.empty()) {
+        return compactJournal(error);
+    }
+    return true;
 }
 
-void ResourceManager::loadFromFile() {
-    std::ifstream file(data_file);
+void ResourceManager::adoptRecords(std::vector<Resource>& loaded) {
+    resources.clear();
+    resources.reserve(loaded.size());
+    for (unsigned int i = 0; i < loaded.size(); i++) {
+        resources.insert(std::move(loaded[i]));
+    }
+    loaded.clear();
+}
+
+bool ResourceManager::writeStore(StorageBackend<Resource>& store, std::string& error) {
+    std::vector<const Resource*> records;
+    records.reserve(resources.size());
+    for (SlabStore<Resource>::const_iterator it = resources.begin(); it != resources.end(); ++it) {
+        records.push_back(&*it);
+    }
     
-    if (!file.is_open()) {
-        return;
+    if (!store.rewrite(records)) {
+        error = "Cannot write '" + store.getPath() + "'.";
+        return false;
+    }
+    
+    backend = &store;
+    return clearJournal(error);
+}
+
+bool ResourceManager::clearJournal(std::string& error) {
+    dirty_ids.clear();
+    if (!journal.reset()) {
+        error = "Cannot clear the journal '" + journal.getLogFile() + "'.";
+        return false;
+    }
+    return true;
+}
+
+bool ResourceManager::loadFrom(StorageFormat format) {
+    std::unique_lock<std::shared_mutex> lock(mutex);
+    std::vector<Resource> loaded;
+    std::vector<DamagedRecord> damaged;
+    if (!stores[format]->load(loaded, damaged)) {
+        return false;
+    }
+    
+    damaged_count = 0;
+    for (unsigned int i = 0; i < damaged.size(); i++) {
+        quarantine(damaged[i].origin, damaged[i].raw);
     }
     
-    std::vector<Resource> temp_resources;
-    std::string line;
     unsigned int max_id = 0;
+    for (unsigned int i = 0; i < loaded.size(); i++) {
+        max_id = (loaded[i].getId() > max_id) ? loaded[i].getId() : max_id;
+    }
     
-    while (std::getline(file, line)) {
-        std::vector<std::string> parts;
-        std::stringstream ss(line);
-        std::string part;
-        
-        while (std::getline(ss, part, '|')) {
-            parts.push_back(part);
-        }
-        
-        if (parts.size() != 4) {
-            file.close();
+    adoptRecords(loaded);
+    backend = stores[format];
+    finishLoad(max_id);
+    return true;
+}
+
+void ResourceManager::load() {
+    for (unsigned int i = 0; i + 1 < STORAGE_FORMAT_COUNT; i++) {
+        StorageFormat format = STORAGE_LOAD_ORDER[i];
+        if (stores[format]->exists() && loadFrom(format)) {
             return;
         }
-        
-        unsigned int id;
-        std::stringstream(parts[0]) >> id;
-        
-        Resource loaded_resource(id, parts[1], parts[2], parts[3] == "1");
-        temp_resources.push_back(loaded_resource);
-        
-        max_id = (id > max_id) ? id : max_id;
     }
+    loadFrom(STORAGE_LOAD_ORDER[STORAGE_FORMAT_COUNT - 1]);
+}
+
+StorageFormat ResourceManager::getStorageFormat() const {
+    std::shared_lock<std::shared_mutex> lock(mutex);
+    return backend->getFormat();
+}
+
+std::string ResourceManager::getStorePath(StorageFormat format) const {
+    return stores[format]->getPath();
+}
+
+void ResourceManager::quarantine(const std::string& origin, std::string_view raw) {
+    quarantineRecord(quarantine_file, origin, raw);
+    damaged_count++;
+}
+
+unsigned int ResourceManager::getDamagedRecordCount() const {
+    std::shared_lock<std::shared_mutex> lock(mutex);
+    return damaged_count;
+}
+
+std::string ResourceManager::getQuarantineFile() const {
+    return quarantine_file;
+}
+
+void ResourceManager::finishLoad(unsigned int max_id) {
+    dirty_ids.clear();
+    rebuildIndexes();
     
-    file.close();
-    resources = temp_resources;
+    unsigned int journal_max_id = replayJournal();
+    max_id = (journal_max_id > max_id) ? journal_max_id : max_id;
     next_id = max_id + 1;
+    std::string error;
+    if (damaged_count > 0 && !writeStore(*backend, error)) {
+        std::cerr << "Warning: " << error << std::endl;
+    }
+    rebuildSearchIndex();
+}
+
+unsigned int ResourceManager::replayJournal() {
+    std::vector<std::string> damaged;
+    std::vector<std::string> entries = journal.readEntries(damaged);
+    for (unsigned int i = 0; i < damaged.size(); i++) {
+        quarantine(journal.getLogFile(), damaged[i]);
+    }
+    unsigned int max_id = 0;
+    
+    for (unsigned int i = 0; i < entries.size(); i++) {
+        std::string_view payload = std::string_view(entries[i]).substr(2);
+        
+        if (entries[i][0] == Journal::PUT) {
+            Resource resource;
+            if (!codec.parseLine(payload, resource)) {
+                quarantine(journal.getLogFile(), entries[i]);
+                continue;
+            }
+            
+            std::unordered_map<unsigned int, unsigned int>::iterator it = id_index.find(resource.getId());
+            if (it != id_index.end()) {
+                unsigned int slot = it->second;
+                unindexResource(slot);
+                resources[slot] = resource;
+                indexResource(slot);
+            } else {
+                indexResource(resources.insert(resource).slot);
+            }
+            markDirty(resource.getId());
+            max_id = (resource.getId() > max_id) ? resource.getId() : max_id;
+        } else if (entries[i][0] == Journal::REMOVE) {
+            unsigned int id;
+            if (!parseUnsigned(payload, id)) {
+                quarantine(journal.getLogFile(), entries[i]);
+                continue;
+            }
+            
+            std::unordered_map<unsigned int, unsigned int>::iterator it = id_index.find(id);
+            if (it != id_index.end()) {
+                unsigned int slot = it->second;
+                unindexResource(slot);
+                resources.erase(slot);
+            }
+            markDirty(id);
+            max_id = (id > max_id) ? id : max_id;
+        }
+    }
+    
+    return max_id;
 }
 
 void ResourceManager::searchResourceById(unsigned int id) const {
@@ -237,49 +742,94 @@ void ResourceManager::searchResourceById(unsigned int id) const {
     }
 }
 
+std::vector<unsigned int> ResourceManager::matchResourcesByName(const std::string& name) const {
+    std::shared_lock<std::shared_mutex> lock(mutex);
+    return matchText(name_trigrams, name, &Resource::getName);
+}
+
+std::vector<unsigned int> ResourceManager::matchResourcesByType(const std::string& type) const {
+    std::shared_lock<std::shared_mutex> lock(mutex);
+    return matchText(type_trigrams, type, &Resource::getType);
+}
+
+const Resource* ResourceManager::getResource(unsigned int id) const {
+    std::unordered_map<unsigned int, unsigned int>::const_iterator it = id_index.find(id);
+    if (it == id_index.end()) {
+        return NULL;
+    }
+    return &resources[it->second];
+}
+
+SlabHandle ResourceManager::getResourceHandle(unsigned int id) const {
+    std::shared_lock<std::shared_mutex> lock(mutex);
+    std::unordered_map<unsigned int, unsigned int>::const_iterator it = id_index.find(id);
+    if (it == id_index.end()) {
+        return NULL_HANDLE;
+    }
+    return resources.handleAt(it->second);
+}
+
+Resource* ResourceManager::findResource(SlabHandle handle) {
+    return resources.get(handle);
+}
+
+const Resource* ResourceManager::getResource(SlabHandle handle) const {
+    return resources.get(handle);
+}
+
+bool ResourceManager::lookupResource(unsigned int id, Resource& resource) const {
+    std::shared_lock<std::shared_mutex> lock(mutex);
+    std::unordered_map<unsigned int, unsigned int>::const_iterator it = id_index.find(id);
+    if (it == id_index.end()) {
+        return false;
+    }
+    resource = resources[it->second];
+    return true;
+}
+
+void ResourceManager::listResources(std::vector<Resource>& snapshot) const {
+    std::shared_lock<std::shared_mutex> lock(mutex);
+    snapshot.clear();
+    snapshot.reserve(resources.size());
+    for (SlabStore<Resource>::const_iterator it = resources.begin(); it != resources.end(); ++it) {
+        snapshot.push_back(*it);
+    }
+}
+
 void ResourceManager::searchResourceByName(const std::string& name) const {
-    std::vector<Resource> found_resources;
-    std::string search_lower = toLowercase(name);
+    std::vector<unsigned int> found_ids = matchResourcesByName(name);
     
-    for (unsigned int i = 0; i < resources.size(); i++) {
-        std::string name_lower = toLowercase(resources[i].getName());
+    if (found_ids.empty()) {
+        std::cout << "No resources found matching name '" << name << "'" << std::endl;
         
-        if (name_lower.find(search_lower) != std::string::npos) {
-            found_resources.push_back(resources[i]);
+        std::vector<FuzzyMatch> suggestions = fuzzyMatchResourcesByName(name, MAX_SUGGESTIONS);
+        if (!suggestions.empty()) {
+            std::cout << "Did you mean:" << std::endl;
+            for (unsigned int i = 0; i < suggestions.size(); i++) {
+                std::cout << "  - " << getResource(suggestions[i].id)->getName() << " (ID: " << suggestions[i].id
+                          << ", " << suggestions[i].distance << " typo(s))" << std::endl;
+            }
         }
-    }
-    
-    if (found_resources.empty()) {
-        std::cout << "No resources found matching name '" << name << "'" << std::endl;
     } else {
         std::cout << "\n=== SEARCH RESULTS ===" << std::endl;
-        std::cout << "Found " << found_resources.size() << " resource(s) matching name '" << name << "':" << std::endl;
-        for (unsigned int i = 0; i < found_resources.size(); i++) {
-            found_resources[i].displayInfo();
+        std::cout << "Found " << found_ids.size() << " resource(s) matching name '" << name << "':" << std::endl;
+        for (unsigned int i = 0; i < found_ids.size(); i++) {
+            getResource(found_ids[i])->displayInfo();
             std::cout << std::endl;
         }
     }
 }
 
 void ResourceManager::searchResourceByType(const std::string& type) const {
-    std::vector<Resource> found_resources;
-    std::string search_lower = toLowercase(type);
-    
-    for (unsigned int i = 0; i < resources.size(); i++) {
-        std::string type_lower = toLowercase(resources[i].getType());
-        
-        if (type_lower.find(search_lower) != std::string::npos) {
-            found_resources.push_back(resources[i]);
-        }
-    }
+    std::vector<unsigned int> found_ids = matchResourcesByType(type);
     
-    if (found_resources.empty()) {
+    if (found_ids.empty()) {
         std::cout << "No resources found matching type '" << type << "'" << std::endl;
     } else {
         std::cout << "\n=== SEARCH RESULTS ===" << std::endl;
-        std::cout << "Found " << found_resources.size() << " resource(s) matching type '" << type << "':" << std::endl;
-        for (unsigned int i = 0; i < found_resources.size(); i++) {
-            found_resources[i].displayInfo();
+        std::cout << "Found " << found_ids.size() << " resource(s) matching type '" << type << "':" << std::endl;
+        for (unsigned int i = 0; i < found_ids.size(); i++) {
+            getResource(found_ids[i])->displayInfo();
             std::cout << std::endl;
         }
     }
@@ -0,0 +1,285 @@
+#include "Server.hpp"
+#include <thread>
+#include <vector>
+#include <unordered_map>
+#include <csignal>
+#include <cerrno>
+#include <cstring>
+#ifdef __linux__
+    #include <sys/epoll.h>
+    #include <sys/socket.h>
+    #include <sys/un.h>
+    #include <unistd.h>
+#endif
+
+static volatile std::sig_atomic_t stop_requested = 0;
+
+static void handleStopSignal(int) {
+    stop_requested = 1;
+}
+
+Server::Server(CampusSystem& system, const std::string& path, unsigned int workers) : campus_system(system) {
+    socket_path = path;
+    worker_count = (workers == 0) ? 1 : workers;
+    listen_fd = -1;
+}
+
+Server::~Server() {
+    stop();
+}
+
+std::string Server::getSocketPath() const {
+    return socket_path;
+}
+
+#ifdef __linux__
+
+static const int MAX_EPOLL_EVENTS = 64;
+static const int EPOLL_TIMEOUT_MS = 200;
+static const std::size_t READ_CHUNK_SIZE = 16384;
+
+bool Server::start(std::string& error) {
+    sockaddr_un address;
+    std::memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    if (socket_path.empty() || socket_path.length() >= sizeof(address.sun_path)) {
+        error = "Socket path must be between 1 and " + std::to_string(sizeof(address.sun_path) - 1) + " characters";
+        return false;
+    }
+    std::memcpy(address.sun_path, socket_path.c_str(), socket_path.length());
+    
+    listen_fd = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (listen_fd < 0) {
+        error = std::string("Cannot create socket: ") + std::strerror(errno);
+        return false;
+    }
+    
+    unlink(socket_path.c_str());
+    if (bind(listen_fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0 ||
+        listen(listen_fd, SOMAXCONN) != 0) {
+        error = "Cannot listen on " + socket_path + ": " + std::strerror(errno);
+        close(listen_fd);
+        listen_fd = -1;
+        return false;
+    }
+    
+    stop_requested = 0;
+    std::signal(SIGINT, handleStopSignal);
+    std::signal(SIGTERM, handleStopSignal);
+    std::signal(SIGPIPE, SIG_IGN);
+    return true;
+}
+
+void Server::run() {
+    std::vector<std::thread> workers;
+    for (unsigned int i = 1; i < worker_count; i++) {
+        workers.push_back(std::thread(&Server::runWorker, this));
+    }
+    runWorker();
+    
+    for (unsigned int i = 0; i < workers.size(); i++) {
+        workers[i].join();
+    }
+}
+
+void Server::stop() {
+    if (listen_fd < 0) {
+        return;
+    }
+    close(listen_fd);
+    listen_fd = -1;
+    unlink(socket_path.c_str());
+}
+
+void Server::runWorker() {
+    int epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+    if (epoll_fd < 0) {
+        return;
+    }
+    
+    epoll_event listen_event;
+    listen_event.events = EPOLLIN | EPOLLEXCLUSIVE;
+    listen_event.data.fd = listen_fd;
+    if (epoll_ctl(epoll_fd, EPOLL_CTL_ADD, listen_fd, &listen_event) != 0) {
+        close(epoll_fd);
+        return;
+    }
+    
+    std::unordered_map<int, Connection> connections;
+    std::vector<int> queued;
+    std::ostringstream response;
+    epoll_event ready[MAX_EPOLL_EVENTS];
+    
+    while (!stop_requested) {
+        std::vector<int> work;
+        work.swap(queued);
+        int ready_count = epoll_wait(epoll_fd, ready, MAX_EPOLL_EVENTS, work.empty() ? EPOLL_TIMEOUT_MS : 0);
+        
+        for (int i = 0; i < ready_count; i++) {
+            int fd = ready[i].data.fd;
+            
+            if (fd == listen_fd) {
+                int client_fd;
+                while ((client_fd = accept4(listen_fd, NULL, NULL, SOCK_NONBLOCK | SOCK_CLOEXEC)) >= 0) {
+                    epoll_event client_event;
+                    client_event.events = EPOLLIN | EPOLLRDHUP;
+                    client_event.data.fd = client_fd;
+                    if (epoll_ctl(epoll_fd, EPOLL_CTL_ADD, client_fd, &client_event) != 0) {
+                        close(client_fd);
+                        continue;
+                    }
+                    Connection& connection = connections[client_fd];
+                    connection.fd = client_fd;
+                    connection.interest = EPOLLIN | EPOLLRDHUP;
+                    connection.peer_closed = false;
+                    connection.queued = false;
+                }
+                continue;
+            }
+            
+            std::unordered_map<int, Connection>::iterator it = connections.find(fd);
+            if (it != connections.end() && !it->second.queued) {
+                it->second.queued = true;
+                work.push_back(fd);
+            }
+        }
+        
+        for (unsigned int i = 0; i < work.size(); i++) {
+            serveConnection(epoll_fd, connections, work[i], queued, response);
+        }
+    }
+    
+    for (std::unordered_map<int, Connection>::iterator it = connections.begin(); it != connections.end(); ++it) {
+        close(it->first);
+    }
+    close(epoll_fd);
+}
+
+void Server::serveConnection(int epoll_fd, std::unordered_map<int, Connection>& connections, int fd,
+                             std::vector<int>& queued, std::ostringstream& response) {
+    std::unordered_map<int, Connection>::iterator it = connections.find(fd);
+    if (it == connections.end()) {
+        return;
+    }
+    
+    Connection& connection = it->second;
+    connection.queued = false;
+    bool keep_open = readRequests(connection, response) && flushOutput(epoll_fd, connection);
+    bool has_request = connection.input.find('\n') != std::string::npos;
+    if (!keep_open || (connection.peer_closed && connection.output.empty() && !has_request)) {
+        close(fd);
+        connections.erase(it);
+        return;
+    }
+    
+    if (has_request && connection.output.length() < MAX_PENDING_OUTPUT) {
+        connection.queued = true;
+        queued.push_back(fd);
+    }
+}
+
+bool Server::readRequests(Connection& connection, std::ostringstream& response) {
+    char buffer[READ_CHUNK_SIZE];
+    
+    while (!connection.peer_closed && connection.output.length() < MAX_PENDING_OUTPUT &&
+           connection.input.length() <= MAX_REQUEST_LENGTH) {
+        ssize_t received = recv(connection.fd, buffer, sizeof(buffer), 0);
+        if (received > 0) {
+            connection.input.append(buffer, received);
+        } else if (received == 0) {
+            connection.peer_closed = true;
+        } else if (errno == EAGAIN || errno == EWOULDBLOCK) {
+            break;
+        } else if (errno != EINTR) {
+            return false;
+        }
+    }
+    
+    std::string::size_type line_start = 0;
+    std::string::size_type line_end;
+    unsigned int handled = 0;
+    while (handled < MAX_REQUESTS_PER_WAKEUP && connection.output.length() < MAX_PENDING_OUTPUT &&
+           (line_end = connection.input.find('\n', line_start)) != std::string::npos) {
+        std::string line = connection.input.substr(line_start, line_end - line_start);
+        line_start = line_end + 1;
+        
+        if (!line.empty() && line[line.length() - 1] == '\r') {
+            line.erase(line.length() - 1);
+        }
+        if (line.empty()) {
+            continue;
+        }
+        
+        response.str("");
+        campus_system.executeCommand(line, response, false);
+        connection.output += response.str();
+        handled++;
+    }
+    connection.input.erase(0, line_start);
+    
+    return connection.input.length() <= MAX_REQUEST_LENGTH || connection.input.find('\n') != std::string::npos;
+}
+
+bool Server::flushOutput(int epoll_fd, Connection& connection) {
+    std::string::size_type sent_total = 0;
+    
+    while (sent_total < connection.output.length()) {
+        ssize_t sent = send(connection.fd, connection.output.data() + sent_total,
+                            connection.output.length() - sent_total, MSG_NOSIGNAL);
+        if (sent >= 0) {
+            sent_total += sent;
+        } else if (errno == EAGAIN || errno == EWOULDBLOCK) {
+            break;
+        } else if (errno != EINTR) {
+            return false;
+        }
+    }
+    connection.output.erase(0, sent_total);
+    
+    unsigned int interest = 0;
+    if (!connection.peer_closed && connection.output.length() < MAX_PENDING_OUTPUT) {
+        interest |= EPOLLIN | EPOLLRDHUP;
+    }
+    if (!connection.output.empty()) {
+        interest |= EPOLLOUT;
+    }
+    if (interest != connection.interest) {
+        epoll_event client_event;
+        client_event.events = interest;
+        client_event.data.fd = connection.fd;
+        if (epoll_ctl(epoll_fd, EPOLL_CTL_MOD, connection.fd, &client_event) != 0) {
+            return false;
+        }
+        connection.interest = interest;
+    }
+    return true;
+}
+
+#else
+
+bool Server::start(std::string& error) {
+    error = "Server mode is only supported on Linux";
+    return false;
+}
+
+void Server::run() {
+}
+
+void Server::stop() {
+}
+
+void Server::runWorker() {
+}
+
+void Server::serveConnection(int, std::unordered_map<int, Connection>&, int, std::vector<int>&, std::ostringstream&) {
+}
+
+bool Server::readRequests(Connection&, std::ostringstream&) {
+    return false;
+}
+
+bool Server::flushOutput(int, Connection&) {
+    return false;
+}
+
+#endif
@@ -0,0 +1,50 @@
+#include "SqliteRow.hpp"
+#include <sqlite3.h>
+
+SqliteRow::SqliteRow(sqlite3_stmt* statement, int first_column)
+    : statement(statement), first_column(first_column), id(0) {
+}
+
+void SqliteRow::setId(unsigned int id) {
+    this->id = id;
+}
+
+void SqliteRow::setInteger(unsigned int column, int64_t value) {
+    sqlite3_bind_int64(statement, first_column + column, value);
+}
+
+void SqliteRow::setText(unsigned int column, std::string_view value) {
+    sqlite3_bind_text(statement, first_column + column, value.data(), static_cast<int>(value.size()), SQLITE_TRANSIENT);
+}
+
+void SqliteRow::setNull(unsigned int column) {
+    sqlite3_bind_null(statement, first_column + column);
+}
+
+unsigned int SqliteRow::getId() const {
+    return id;
+}
+
+int64_t SqliteRow::getInteger(unsigned int column) const {
+    return sqlite3_column_int64(statement, first_column + column);
+}
+
+std::string_view SqliteRow::getText(unsigned int column) const {
+    const unsigned char* text = sqlite3_column_text(statement, first_column + column);
+    if (text == NULL) {
+        return std::string_view();
+    }
+    return std::string_view(reinterpret_cast<const char*>(text), sqlite3_column_bytes(statement, first_column + column));
+}
+
+bool SqliteRow::isNull(unsigned int column) const {
+    return sqlite3_column_type(statement, first_column + column) == SQLITE_NULL;
+}
+
+std::vector<unsigned int>& SqliteRow::getLinks() {
+    return links;
+}
+
+const std::vector<unsigned int>& SqliteRow::getLinks() const {
+    return links;
+}
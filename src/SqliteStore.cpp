@@ -0,0 +1,262 @@
+#include "SqliteStore.hpp"
+#include "DurableFile.hpp"
+#include <sqlite3.h>
+#include <cstdio>
+#include <filesystem>
+
+static sqlite3* openDatabase(const std::string& path, int flags) {
+    sqlite3* db = NULL;
+    if (sqlite3_open_v2(path.c_str(), &db, flags, NULL) != SQLITE_OK) {
+        sqlite3_close(db);
+        return NULL;
+    }
+
+    sqlite3_busy_timeout(db, SqliteDatabase::BUSY_TIMEOUT_MS);
+    if (sqlite3_exec(db, "PRAGMA synchronous = FULL", NULL, NULL, NULL) != SQLITE_OK) {
+        sqlite3_close(db);
+        return NULL;
+    }
+    return db;
+}
+
+static bool finishTransaction(sqlite3* db, bool succeeded) {
+    if (succeeded && sqlite3_exec(db, "COMMIT", NULL, NULL, NULL) == SQLITE_OK) {
+        return true;
+    }
+    sqlite3_exec(db, "ROLLBACK", NULL, NULL, NULL);
+    return false;
+}
+
+static bool runStatement(sqlite3_stmt* statement, unsigned int id) {
+    sqlite3_bind_int64(statement, 1, id);
+    bool succeeded = sqlite3_step(statement) == SQLITE_DONE;
+    sqlite3_reset(statement);
+    return succeeded;
+}
+
+SqliteDatabase::SqliteDatabase(const std::string& path, const SqliteTable& table)
+    : path(path), table(table), attached(false) {
+    std::string columns = "id";
+    std::string parameters = "?";
+    table_sql = "CREATE TABLE IF NOT EXISTS " + table.name + " (id INTEGER PRIMARY KEY";
+    for (unsigned int i = 0; i < table.columns.size(); i++) {
+        const SqliteColumn& column = table.columns[i];
+        table_sql += ", " + column.name + " " + column.type;
+        columns += ", " + column.name;
+        parameters += ", ?";
+        if (column.indexed) {
+            index_sql += "CREATE INDEX IF NOT EXISTS " + table.name + "_" + column.name +
+                         " ON " + table.name + " (" + column.name + ");";
+        }
+    }
+    table_sql += ");";
+    select_sql = "SELECT " + columns + " FROM " + table.name + " ORDER BY id";
+    insert_sql = "INSERT OR REPLACE INTO " + table.name + " (" + columns + ") VALUES (" + parameters + ")";
+    delete_sql = "DELETE FROM " + table.name + " WHERE id = ?";
+
+    if (!table.link_table.empty()) {
+        table_sql += "CREATE TABLE IF NOT EXISTS " + table.link_table + " (" + table.link_owner +
+                     " INTEGER NOT NULL, position INTEGER NOT NULL, " + table.link_column +
+                     " INTEGER NOT NULL, PRIMARY KEY (" + table.link_owner + ", position)) WITHOUT ROWID;";
+        index_sql += "CREATE INDEX IF NOT EXISTS " + table.link_table + "_" + table.link_column +
+                     " ON " + table.link_table + " (" + table.link_column + ");";
+        link_select_sql = "SELECT " + table.link_owner + ", " + table.link_column + " FROM " + table.link_table +
+                          " ORDER BY " + table.link_owner + ", position";
+        link_insert_sql = "INSERT INTO " + table.link_table + " (" + table.link_owner + ", position, " +
+                          table.link_column + ") VALUES (?, ?, ?)";
+        link_delete_sql = "DELETE FROM " + table.link_table + " WHERE " + table.link_owner + " = ?";
+    }
+}
+
+sqlite3* SqliteDatabase::connect(bool create) const {
+    int flags = create ? SQLITE_OPEN_READWRITE | SQLITE_OPEN_CREATE : SQLITE_OPEN_READWRITE;
+    sqlite3* db = openDatabase(path, flags);
+    if (db != NULL && create && sqlite3_exec(db, (table_sql + index_sql).c_str(), NULL, NULL, NULL) != SQLITE_OK) {
+        sqlite3_close(db);
+        return NULL;
+    }
+    return db;
+}
+
+bool SqliteDatabase::hasTable(sqlite3* db) const {
+    sqlite3_stmt* query = NULL;
+    if (sqlite3_prepare_v2(db, "SELECT 1 FROM sqlite_master WHERE type = 'table' AND name = ?", -1,
+                           &query, NULL) != SQLITE_OK) {
+        return false;
+    }
+    sqlite3_bind_text(query, 1, table.name.c_str(), -1, SQLITE_STATIC);
+    bool found = sqlite3_step(query) == SQLITE_ROW;
+    sqlite3_finalize(query);
+    return found;
+}
+
+bool SqliteDatabase::putRows(sqlite3* db, unsigned int count, const RowWriter& write, bool replace) const {
+    sqlite3_stmt* insert = NULL;
+    sqlite3_stmt* link_insert = NULL;
+    sqlite3_stmt* link_delete = NULL;
+    bool linked = !table.link_table.empty();
+    bool succeeded = sqlite3_prepare_v2(db, insert_sql.c_str(), -1, &insert, NULL) == SQLITE_OK;
+    if (succeeded && linked) {
+        succeeded = sqlite3_prepare_v2(db, link_insert_sql.c_str(), -1, &link_insert, NULL) == SQLITE_OK &&
+                    sqlite3_prepare_v2(db, link_delete_sql.c_str(), -1, &link_delete, NULL) == SQLITE_OK;
+    }
+
+    SqliteRow row(insert, 2);
+    for (unsigned int i = 0; i < count && succeeded; i++) {
+        row.getLinks().clear();
+        write(i, row);
+        sqlite3_bind_int64(insert, 1, row.getId());
+        succeeded = sqlite3_step(insert) == SQLITE_DONE;
+        sqlite3_reset(insert);
+
+        if (succeeded && linked && replace) {
+            succeeded = runStatement(link_delete, row.getId());
+        }
+        const std::vector<unsigned int>& links = row.getLinks();
+        for (unsigned int j = 0; j < links.size() && succeeded && linked; j++) {
+            sqlite3_bind_int64(link_insert, 2, j);
+            sqlite3_bind_int64(link_insert, 3, links[j]);
+            succeeded = runStatement(link_insert, row.getId());
+        }
+    }
+    sqlite3_finalize(insert);
+    sqlite3_finalize(link_insert);
+    sqlite3_finalize(link_delete);
+    return succeeded;
+}
+
+bool SqliteDatabase::removeRows(sqlite3* db, const std::vector<unsigned int>& ids) const {
+    sqlite3_stmt* remove = NULL;
+    sqlite3_stmt* link_delete = NULL;
+    bool linked = !table.link_table.empty();
+    bool succeeded = sqlite3_prepare_v2(db, delete_sql.c_str(), -1, &remove, NULL) == SQLITE_OK;
+    if (succeeded && linked) {
+        succeeded = sqlite3_prepare_v2(db, link_delete_sql.c_str(), -1, &link_delete, NULL) == SQLITE_OK;
+    }
+
+    for (unsigned int i = 0; i < ids.size() && succeeded; i++) {
+        succeeded = runStatement(remove, ids[i]) && (!linked || runStatement(link_delete, ids[i]));
+    }
+    sqlite3_finalize(remove);
+    sqlite3_finalize(link_delete);
+    return succeeded;
+}
+
+bool SqliteDatabase::readRows(sqlite3* db, const RowReader& read, std::vector<DamagedRecord>& damaged) const {
+    sqlite3_stmt* select = NULL;
+    sqlite3_stmt* link_select = NULL;
+    bool linked = !table.link_table.empty();
+    if (sqlite3_prepare_v2(db, select_sql.c_str(), -1, &select, NULL) != SQLITE_OK ||
+        (linked && sqlite3_prepare_v2(db, link_select_sql.c_str(), -1, &link_select, NULL) != SQLITE_OK)) {
+        sqlite3_finalize(select);
+        return false;
+    }
+
+    SqliteRow row(select, 1);
+    int link_status = linked ? sqlite3_step(link_select) : SQLITE_DONE;
+    int status;
+    while ((status = sqlite3_step(select)) == SQLITE_ROW) {
+        sqlite3_int64 id = sqlite3_column_int64(select, 0);
+        row.setId(static_cast<unsigned int>(id));
+        row.getLinks().clear();
+        while (link_status == SQLITE_ROW && sqlite3_column_int64(link_select, 0) <= id) {
+            if (sqlite3_column_int64(link_select, 0) == id) {
+                row.getLinks().push_back(static_cast<unsigned int>(sqlite3_column_int64(link_select, 1)));
+            }
+            link_status = sqlite3_step(link_select);
+        }
+
+        if (!read(row)) {
+            std::string raw = std::to_string(id);
+            for (unsigned int i = 0; i < table.columns.size(); i++) {
+                raw += '|';
+                raw += row.getText(i);
+            }
+            for (unsigned int i = 0; i < row.getLinks().size(); i++) {
+                raw += (i == 0) ? '|' : ',';
+                raw += std::to_string(row.getLinks()[i]);
+            }
+            damaged.push_back(DamagedRecord{path + " row " + std::to_string(id), raw});
+        }
+    }
+    sqlite3_finalize(select);
+    sqlite3_finalize(link_select);
+    return status == SQLITE_DONE && (link_status == SQLITE_DONE || link_status == SQLITE_ROW);
+}
+
+bool SqliteDatabase::read(const RowReader& read, std::vector<DamagedRecord>& damaged) {
+    damaged.clear();
+    attached = false;
+
+    sqlite3* db = connect(false);
+    if (db == NULL) {
+        return false;
+    }
+    bool succeeded = hasTable(db) &&
+                     sqlite3_exec(db, (table_sql + index_sql).c_str(), NULL, NULL, NULL) == SQLITE_OK &&
+                     readRows(db, read, damaged);
+    sqlite3_close(db);
+
+    attached = succeeded;
+    return succeeded;
+}
+
+bool SqliteDatabase::commit(unsigned int count, const RowWriter& write, const std::vector<unsigned int>& removals) {
+    if (!attached) {
+        return false;
+    }
+
+    sqlite3* db = connect(true);
+    if (db == NULL) {
+        return false;
+    }
+
+    bool succeeded = sqlite3_exec(db, "BEGIN IMMEDIATE", NULL, NULL, NULL) == SQLITE_OK;
+    if (succeeded) {
+        succeeded = finishTransaction(db, putRows(db, count, write, true) && removeRows(db, removals));
+    }
+    sqlite3_close(db);
+    return succeeded;
+}
+
+bool SqliteDatabase::rewrite(unsigned int count, const RowWriter& write) {
+    std::string temp_path = path + ".tmp";
+    std::remove(temp_path.c_str());
+    std::remove((temp_path + "-journal").c_str());
+
+    sqlite3* current = connect(true);
+    std::error_code error;
+    if (current == NULL || sqlite3_close(current) != SQLITE_OK ||
+        std::filesystem::exists(path + "-journal", error) || error) {
+        return false;
+    }
+
+    sqlite3* db = openDatabase(temp_path, SQLITE_OPEN_READWRITE | SQLITE_OPEN_CREATE);
+    if (db == NULL) {
+        return false;
+    }
+
+    bool succeeded = sqlite3_exec(db, "PRAGMA journal_mode = OFF", NULL, NULL, NULL) == SQLITE_OK &&
+                     sqlite3_exec(db, "BEGIN", NULL, NULL, NULL) == SQLITE_OK;
+    if (succeeded) {
+        succeeded = finishTransaction(db, sqlite3_exec(db, table_sql.c_str(), NULL, NULL, NULL) == SQLITE_OK &&
+                                          putRows(db, count, write, false) &&
+                                          sqlite3_exec(db, index_sql.c_str(), NULL, NULL, NULL) == SQLITE_OK);
+    }
+    succeeded = sqlite3_close(db) == SQLITE_OK && succeeded;
+
+    if (!succeeded || std::rename(temp_path.c_str(), path.c_str()) != 0 || !syncDirectoryOf(path)) {
+        std::remove(temp_path.c_str());
+        return false;
+    }
+    attached = true;
+    return true;
+}
+
+bool SqliteDatabase::isAttached() const {
+    return attached;
+}
+
+std::string SqliteDatabase::getPath() const {
+    return path;
+}
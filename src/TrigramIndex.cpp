@@ -0,0 +1,233 @@
+#include "TrigramIndex.hpp"
+#include "outils.hpp"
+#include "ParallelLoad.hpp"
+#include <algorithm>
+#include <limits>
+#include <functional>
+
+static const std::size_t MIN_ENTRIES_PER_PART = 16 * 1024;
+
+void TrigramIndex::collectTrigrams(std::string_view text, std::vector<unsigned int>& keys) const {
+    keys.clear();
+    if (text.size() < TRIGRAM_LENGTH) {
+        return;
+    }
+    
+    for (std::string_view::size_type i = 0; i + TRIGRAM_LENGTH <= text.size(); i++) {
+        keys.push_back(static_cast<unsigned int>(static_cast<unsigned char>(foldCase(text[i]))) << 16 |
+                       static_cast<unsigned int>(static_cast<unsigned char>(foldCase(text[i + 1]))) << 8 |
+                       static_cast<unsigned int>(static_cast<unsigned char>(foldCase(text[i + 2]))));
+    }
+    std::sort(keys.begin(), keys.end());
+    keys.erase(std::unique(keys.begin(), keys.end()), keys.end());
+}
+
+TrigramIndex::TrigramIndex() {
+    max_id = 0;
+}
+
+void TrigramIndex::add(unsigned int id, std::string_view text) {
+    max_id = (id > max_id) ? id : max_id;
+    std::vector<unsigned int> keys;
+    collectTrigrams(text, keys);
+    
+    for (unsigned int i = 0; i < keys.size(); i++) {
+        std::vector<unsigned int>& ids = postings[keys[i]];
+        if (ids.empty() || ids.back() < id) {
+            ids.push_back(id);
+            continue;
+        }
+        
+        std::vector<unsigned int>::iterator it = std::lower_bound(ids.begin(), ids.end(), id);
+        if (*it != id) {
+            ids.insert(it, id);
+        }
+    }
+}
+
+void TrigramIndex::addAll(const std::vector<std::pair<unsigned int, std::string_view> >& entries) {
+    unsigned int part_count = partCount(entries.size(), MIN_ENTRIES_PER_PART);
+    std::vector<std::unordered_map<unsigned int, std::vector<unsigned int> > > parts(part_count);
+    
+    runParallel(part_count, [&](unsigned int part) {
+        std::vector<unsigned int> keys;
+        std::unordered_map<unsigned int, std::vector<unsigned int> >& part_postings = parts[part];
+        std::size_t end = entries.size() * (part + 1) / part_count;
+        for (std::size_t i = entries.size() * part / part_count; i < end; i++) {
+            collectTrigrams(entries[i].second, keys);
+            for (unsigned int k = 0; k < keys.size(); k++) {
+                part_postings[keys[k]].push_back(entries[i].first);
+            }
+        }
+    });
+    
+    for (unsigned int part = 0; part < part_count; part++) {
+        std::unordered_map<unsigned int, std::vector<unsigned int> >::iterator it = parts[part].begin();
+        for (; it != parts[part].end(); ++it) {
+            std::vector<unsigned int>& ids = postings[it->first];
+            if (ids.empty()) {
+                ids.swap(it->second);
+            } else {
+                ids.insert(ids.end(), it->second.begin(), it->second.end());
+            }
+        }
+    }
+    
+    std::unordered_map<unsigned int, std::vector<unsigned int> >::iterator posting = postings.begin();
+    for (; posting != postings.end(); ++posting) {
+        std::vector<unsigned int>& ids = posting->second;
+        if (std::adjacent_find(ids.begin(), ids.end(), std::greater_equal<unsigned int>()) != ids.end()) {
+            std::sort(ids.begin(), ids.end());
+            ids.erase(std::unique(ids.begin(), ids.end()), ids.end());
+        }
+    }
+    for (unsigned int i = 0; i < entries.size(); i++) {
+        max_id = (entries[i].first > max_id) ? entries[i].first : max_id;
+    }
+}
+
+void TrigramIndex::remove(unsigned int id, std::string_view text) {
+    std::vector<unsigned int> keys;
+    collectTrigrams(text, keys);
+    
+    for (unsigned int i = 0; i < keys.size(); i++) {
+        std::unordered_map<unsigned int, std::vector<unsigned int> >::iterator posting = postings.find(keys[i]);
+        if (posting == postings.end()) {
+            continue;
+        }
+        
+        std::vector<unsigned int>& ids = posting->second;
+        std::vector<unsigned int>::iterator it = std::lower_bound(ids.begin(), ids.end(), id);
+        if (it != ids.end() && *it == id) {
+            ids.erase(it);
+        }
+        if (ids.empty()) {
+            postings.erase(posting);
+        }
+    }
+}
+
+void TrigramIndex::clear() {
+    postings.clear();
+    max_id = 0;
+}
+
+bool TrigramIndex::findCandidates(std::string_view lowered_term, std::vector<unsigned int>& ids) const {
+    ids.clear();
+    std::vector<unsigned int> keys;
+    collectTrigrams(lowered_term, keys);
+    if (keys.empty()) {
+        return false;
+    }
+    
+    std::vector<const std::vector<unsigned int>*> lists;
+    for (unsigned int i = 0; i < keys.size(); i++) {
+        std::unordered_map<unsigned int, std::vector<unsigned int> >::const_iterator posting = postings.find(keys[i]);
+        if (posting == postings.end()) {
+            return true;
+        }
+        lists.push_back(&posting->second);
+    }
+    
+    std::sort(lists.begin(), lists.end(), [](const std::vector<unsigned int>* a, const std::vector<unsigned int>* b) {
+        return a->size() < b->size();
+    });
+    
+    ids = *lists[0];
+    for (unsigned int i = 1; i < lists.size() && !ids.empty(); i++) {
+        std::vector<unsigned int>::size_type kept = 0;
+        std::vector<unsigned int>::const_iterator other = lists[i]->begin();
+        
+        for (unsigned int j = 0; j < ids.size(); j++) {
+            other = std::lower_bound(other, lists[i]->end(), ids[j]);
+            if (other == lists[i]->end()) {
+                break;
+            }
+            if (*other == ids[j]) {
+                ids[kept++] = ids[j];
+            }
+        }
+        ids.resize(kept);
+    }
+    return true;
+}
+
+int TrigramIndex::findSimilarCandidates(std::string_view lowered_term, std::vector<unsigned int>& ids) const {
+    ids.clear();
+    std::vector<unsigned int> keys;
+    collectTrigrams(lowered_term, keys);
+    
+    int max_distance = keys.empty() ? 0 : static_cast<int>(keys.size() - 1) / static_cast<int>(TRIGRAMS_PER_EDIT);
+    if (max_distance > MAX_TYPO_DISTANCE) {
+        max_distance = MAX_TYPO_DISTANCE;
+    }
+    if (max_distance == 0) {
+        return 0;
+    }
+    
+    unsigned int min_shared = keys.size() - TRIGRAMS_PER_EDIT * max_distance;
+    if (min_shared > std::numeric_limits<unsigned char>::max()) {
+        return 0;
+    }
+    std::vector<unsigned char> shared(max_id + 1, 0);
+    
+    for (unsigned int i = 0; i < keys.size(); i++) {
+        std::unordered_map<unsigned int, std::vector<unsigned int> >::const_iterator posting = postings.find(keys[i]);
+        if (posting == postings.end()) {
+            continue;
+        }
+        
+        const std::vector<unsigned int>& posting_ids = posting->second;
+        for (unsigned int j = 0; j < posting_ids.size(); j++) {
+            if (++shared[posting_ids[j]] == min_shared) {
+                ids.push_back(posting_ids[j]);
+            }
+        }
+    }
+    return max_distance;
+}
+
+FuzzyRanker::FuzzyRanker(std::string_view lowered_term, int max_distance, unsigned int max_results) {
+    term = lowered_term;
+    distance_limit = max_distance;
+    result_limit = max_results;
+    for (int i = 0; i <= TrigramIndex::MAX_TYPO_DISTANCE; i++) {
+        distance_counts[i] = 0;
+    }
+}
+
+void FuzzyRanker::consider(unsigned int id, std::string_view text) {
+    int distance = boundedSubstringDistance(text, term, distance_limit, rows);
+    if (distance > distance_limit) {
+        return;
+    }
+    
+    unsigned int length_gap = (text.size() > term.size()) ? text.size() - term.size() : term.size() - text.size();
+    matches.push_back(FuzzyMatch{id, distance, length_gap});
+    distance_counts[distance]++;
+    
+    unsigned int at_or_below = 0;
+    for (int d = 0; d < distance_limit; d++) {
+        at_or_below += distance_counts[d];
+        if (at_or_below >= result_limit) {
+            distance_limit = d;
+            break;
+        }
+    }
+}
+
+std::vector<FuzzyMatch> FuzzyRanker::finish() {
+    std::vector<FuzzyMatch>::size_type result_count = std::min<std::vector<FuzzyMatch>::size_type>(result_limit, matches.size());
+    std::partial_sort(matches.begin(), matches.begin() + result_count, matches.end(),
+                      [](const FuzzyMatch& a, const FuzzyMatch& b) {
+        if (a.distance != b.distance) {
+            return a.distance < b.distance;
+        }
+        if (a.length_gap != b.length_gap) {
+            return a.length_gap < b.length_gap;
+        }
+        return a.id < b.id;
+    });
+    matches.resize(result_count);
+    return matches;
+}
@@ -0,0 +1,390 @@
+#include "UtilizationReport.hpp"
+#include "Recurrence.hpp"
+#include "outils.hpp"
+#include <algorithm>
+#include <unordered_map>
+#include <sstream>
+#include <iomanip>
+
+static const char* const WEEKDAY_NAMES[7] = {"Mon", "Tue", "Wed", "Thu", "Fri", "Sat", "Sun"};
+static const char* const HEAT_SHADES = " .:-=+*#%@";
+static const unsigned int HEAT_SHADE_COUNT = 10;
+static const unsigned int LISTED_RESOURCES = 10;
+
+static std::string formatClock(int minutes) {
+    std::string clock = "00:00";
+    clock[0] = '0' + (minutes / 60) / 10;
+    clock[1] = '0' + (minutes / 60) % 10;
+    clock[3] = '0' + (minutes % 60) / 10;
+    clock[4] = '0' + (minutes % 60) % 10;
+    return clock;
+}
+
+static std::string formatDecimal(double value) {
+    std::ostringstream text;
+    text << std::fixed << std::setprecision(1) << value;
+    return text.str();
+}
+
+static std::string csvField(const std::string& text) {
+    if (text.find_first_of(",\"\n") == std::string::npos) {
+        return text;
+    }
+
+    std::string quoted = "\"";
+    for (unsigned int i = 0; i < text.size(); i++) {
+        quoted += (text[i] == '"') ? "\"\"" : std::string(1, text[i]);
+    }
+    return quoted + "\"";
+}
+
+UtilizationReport::UtilizationReport() {
+    first_day = 0;
+    day_count = 0;
+    day_start = 0;
+    day_end = 1440;
+}
+
+long UtilizationReport::getOpenMinutes() const {
+    return static_cast<long>(day_count) * (day_end - day_start);
+}
+
+std::string UtilizationReport::describeRange() const {
+    return stampToDate(first_day * 1440) + " to " + stampToDate((first_day + day_count - 1) * 1440);
+}
+
+void UtilizationReport::begin(const std::vector<Resource>& campus_resources, long first_day, unsigned int day_count,
+                              int day_start, int day_end) {
+    this->first_day = first_day;
+    this->day_count = day_count;
+    this->day_start = day_start;
+    this->day_end = day_end;
+    resources.clear();
+    types.clear();
+    contended.clear();
+    heatmap.assign(HEATMAP_CELLS, 0);
+    resource_types.clear();
+
+    unsigned int max_id = 0;
+    for (unsigned int i = 0; i < campus_resources.size(); i++) {
+        max_id = std::max(max_id, campus_resources[i].getId());
+    }
+    resource_slots.assign(max_id + 1, 0);
+
+    std::unordered_map<std::string, unsigned int, CaseInsensitiveHash, CaseInsensitiveEqual> type_index;
+    for (unsigned int i = 0; i < campus_resources.size(); i++) {
+        const Resource& resource = campus_resources[i];
+        std::pair<std::unordered_map<std::string, unsigned int, CaseInsensitiveHash, CaseInsensitiveEqual>::iterator,
+                  bool> type = type_index.insert(std::make_pair(resource.getType(), types.size()));
+        if (type.second) {
+            types.push_back(TypeUsage{resource.getType(), 0, 0, 0});
+        }
+        types[type.first->second].resource_count++;
+
+        resource_slots[resource.getId()] = resources.size() + 1;
+        resource_types.push_back(type.first->second);
+        resources.push_back(ResourceUsage{resource.getId(), resource.getName(), resource.getType(), 0, 0, 0, 0, 0});
+    }
+
+    day_minutes.assign(resources.size() * day_count, 0);
+    hour_minutes.assign(static_cast<std::size_t>(day_count) * 24, 0);
+    type_heatmaps.assign(types.size() * HEATMAP_CELLS, 0);
+}
+
+void UtilizationReport::addBooking(const ResourceIdList& resource_ids, long start, long end) {
+    start = std::max(start, first_day * 1440);
+    end = std::min(end, (first_day + day_count) * 1440);
+    chunks.clear();
+
+    for (long day = stampToDay(start); day * 1440 < end; day++) {
+        long day_base = day * 1440;
+        long from = std::max(start, day_base + day_start);
+        long to = std::min(end, day_base + day_end);
+        unsigned int day_index = day - first_day;
+        unsigned int weekday = weekdayOfDay(day);
+
+        while (from < to) {
+            unsigned int hour = (from - day_base) / 60;
+            long next = std::min(to, day_base + (hour + 1) * 60L);
+            chunks.push_back(HourChunk{day_index, day_index * 24 + hour, weekday * 24 + hour,
+                                       static_cast<unsigned int>(next - from)});
+            from = next;
+        }
+    }
+    if (chunks.empty()) {
+        return;
+    }
+
+    for (unsigned int r = 0; r < resource_ids.size(); r++) {
+        unsigned int slot = (resource_ids[r] < resource_slots.size()) ? resource_slots[resource_ids[r]] : 0;
+        if (slot == 0) {
+            continue;
+        }
+
+        resources[slot - 1].bookings++;
+        uint16_t* days = &day_minutes[static_cast<std::size_t>(slot - 1) * day_count];
+        long* heat = &type_heatmaps[static_cast<std::size_t>(resource_types[slot - 1]) * HEATMAP_CELLS];
+        for (unsigned int i = 0; i < chunks.size(); i++) {
+            const HourChunk& chunk = chunks[i];
+            unsigned int minutes = days[chunk.day] + chunk.minutes;
+            days[chunk.day] = static_cast<uint16_t>(std::min(minutes, 0xFFFFu));
+            heat[chunk.heat_cell] += chunk.minutes;
+            hour_minutes[chunk.hour_cell] += chunk.minutes;
+        }
+    }
+}
+
+void UtilizationReport::finish() {
+    long week_origin = first_day - weekdayOfDay(first_day);
+
+    for (unsigned int slot = 0; slot < resources.size(); slot++) {
+        ResourceUsage& usage = resources[slot];
+        const uint16_t* days = &day_minutes[static_cast<std::size_t>(slot) * day_count];
+        long week = -1;
+        long week_minutes = 0;
+
+        for (unsigned int d = 0; d < day_count; d++) {
+            usage.booked_minutes += days[d];
+            if (days[d] > usage.peak_day_minutes) {
+                usage.peak_day_minutes = days[d];
+                usage.peak_day = first_day + d;
+            }
+            if ((first_day + d - week_origin) / 7 != week) {
+                week = (first_day + d - week_origin) / 7;
+                week_minutes = 0;
+            }
+            week_minutes += days[d];
+            usage.peak_week_minutes = std::max(usage.peak_week_minutes, week_minutes);
+        }
+
+        TypeUsage& type = types[resource_types[slot]];
+        type.booked_minutes += usage.booked_minutes;
+        type.idle_count += (usage.booked_minutes == 0) ? 1 : 0;
+    }
+
+    for (unsigned int t = 0; t < types.size(); t++) {
+        for (unsigned int cell = 0; cell < HEATMAP_CELLS; cell++) {
+            heatmap[cell] += type_heatmaps[t * HEATMAP_CELLS + cell];
+        }
+    }
+
+    std::vector<unsigned int> hours;
+    for (unsigned int i = 0; i < hour_minutes.size(); i++) {
+        if (hour_minutes[i] > 0) {
+            hours.push_back(i);
+        }
+    }
+    unsigned int top = std::min<std::size_t>(CONTENDED_SLOT_COUNT, hours.size());
+    std::partial_sort(hours.begin(), hours.begin() + top, hours.end(), [this](unsigned int a, unsigned int b) {
+        return hour_minutes[a] != hour_minutes[b] ? hour_minutes[a] > hour_minutes[b] : a < b;
+    });
+    for (unsigned int i = 0; i < top; i++) {
+        contended.push_back(ContendedSlot{(first_day + hours[i] / 24) * 1440 + (hours[i] % 24) * 60,
+                                          static_cast<long>(hour_minutes[hours[i]])});
+    }
+
+    std::vector<uint16_t>().swap(day_minutes);
+    std::vector<uint32_t>().swap(hour_minutes);
+    std::vector<long>().swap(type_heatmaps);
+}
+
+const std::vector<ResourceUsage>& UtilizationReport::getResources() const {
+    return resources;
+}
+
+const std::vector<TypeUsage>& UtilizationReport::getTypes() const {
+    return types;
+}
+
+const std::vector<long>& UtilizationReport::getHeatmap() const {
+    return heatmap;
+}
+
+const std::vector<ContendedSlot>& UtilizationReport::getContendedSlots() const {
+    return contended;
+}
+
+unsigned int UtilizationReport::getIdleCount() const {
+    unsigned int idle = 0;
+    for (unsigned int t = 0; t < types.size(); t++) {
+        idle += types[t].idle_count;
+    }
+    return idle;
+}
+
+long UtilizationReport::getBookedMinutes() const {
+    long booked = 0;
+    for (unsigned int t = 0; t < types.size(); t++) {
+        booked += types[t].booked_minutes;
+    }
+    return booked;
+}
+
+void UtilizationReport::print(std::ostream& output) const {
+    double open_minutes = static_cast<double>(getOpenMinutes());
+    double campus_minutes = open_minutes * resources.size();
+
+    output << "=== UTILIZATION REPORT ===" << std::endl;
+    output << "Period: " << describeRange() << " (" << day_count << " day(s), "
+           << formatClock(day_start) << "-" << formatClock(day_end) << ")" << std::endl;
+    output << "Resources: " << resources.size() << " (" << getIdleCount() << " idle)" << std::endl;
+    output << "Booked: " << getBookedMinutes() << " minutes ("
+           << formatDecimal(campus_minutes > 0 ? getBookedMinutes() * 100.0 / campus_minutes : 0)
+           << "% of open hours)" << std::endl;
+
+    output << std::endl << "By type:" << std::endl;
+    for (unsigned int t = 0; t < types.size(); t++) {
+        output << "  " << types[t].type << ": " << types[t].resource_count << " resource(s), "
+               << types[t].idle_count << " idle, " << types[t].booked_minutes << " minutes ("
+               << formatDecimal(types[t].booked_minutes * 100.0 / (open_minutes * types[t].resource_count))
+               << "%)" << std::endl;
+    }
+
+    std::vector<unsigned int> order;
+    for (unsigned int i = 0; i < resources.size(); i++) {
+        if (resources[i].booked_minutes > 0) {
+            order.push_back(i);
+        }
+    }
+    unsigned int listed = std::min<std::size_t>(LISTED_RESOURCES, order.size());
+    std::partial_sort(order.begin(), order.begin() + listed, order.end(), [this](unsigned int a, unsigned int b) {
+        return resources[a].booked_minutes != resources[b].booked_minutes ?
+               resources[a].booked_minutes > resources[b].booked_minutes : a < b;
+    });
+
+    output << std::endl << "Busiest resources:" << std::endl;
+    for (unsigned int i = 0; i < listed; i++) {
+        const ResourceUsage& usage = resources[order[i]];
+        output << "  ID " << usage.id << " " << usage.name << " (" << usage.type << "): " << usage.booked_minutes
+               << " minutes in " << usage.bookings << " booking(s), "
+               << formatDecimal(usage.booked_minutes * 100.0 / open_minutes) << "%, peak day "
+               << stampToDate(usage.peak_day * 1440) << " (" << usage.peak_day_minutes << " minutes)" << std::endl;
+    }
+    if (listed == 0) {
+        output << "  None" << std::endl;
+    }
+
+    output << std::endl << "Idle resources: " << getIdleCount() << std::endl;
+    for (unsigned int i = 0, shown = 0; i < resources.size() && shown < LISTED_RESOURCES; i++) {
+        if (resources[i].booked_minutes == 0) {
+            output << "  ID " << resources[i].id << " " << resources[i].name << " (" << resources[i].type << ")" << std::endl;
+            shown++;
+        }
+    }
+    if (getIdleCount() > LISTED_RESOURCES) {
+        output << "  ... and " << getIdleCount() - LISTED_RESOURCES << " more" << std::endl;
+    }
+
+    long peak = *std::max_element(heatmap.begin(), heatmap.end());
+    output << std::endl << "Peak hours (darker = busier):" << std::endl;
+    output << "     000000000011111111112222" << std::endl;
+    output << "     012345678901234567890123" << std::endl;
+    for (unsigned int weekday = 0; weekday < 7; weekday++) {
+        output << WEEKDAY_NAMES[weekday] << "  ";
+        for (unsigned int hour = 0; hour < 24; hour++) {
+            long minutes = heatmap[weekday * 24 + hour];
+            unsigned int shade = (peak > 0 && minutes > 0) ? 1 + (minutes * (HEAT_SHADE_COUNT - 2)) / peak : 0;
+            output << HEAT_SHADES[shade];
+        }
+        output << std::endl;
+    }
+
+    output << std::endl << "Most contended hours:" << std::endl;
+    for (unsigned int i = 0; i < contended.size(); i++) {
+        double busy = contended[i].busy_minutes / 60.0;
+        output << "  " << stampToDate(contended[i].start_stamp) << " " << stampToTime(contended[i].start_stamp)
+               << "-" << stampToTime(contended[i].start_stamp + 60) << ": " << formatDecimal(busy) << " of "
+               << resources.size() << " resources busy ("
+               << formatDecimal(busy * 100.0 / resources.size()) << "%)" << std::endl;
+    }
+    if (contended.empty()) {
+        output << "  None" << std::endl;
+    }
+}
+
+void UtilizationReport::writeCsv(std::ostream& output) const {
+    double open_minutes = static_cast<double>(getOpenMinutes());
+
+    output << "resource_id,name,type,bookings,booked_minutes,utilization_percent,minutes_per_day,"
+           << "minutes_per_week,peak_day,peak_day_minutes,peak_week_minutes\n";
+    for (unsigned int i = 0; i < resources.size(); i++) {
+        const ResourceUsage& usage = resources[i];
+        output << usage.id << ',' << csvField(usage.name) << ',' << csvField(usage.type) << ','
+               << usage.bookings << ',' << usage.booked_minutes << ','
+               << formatDecimal(usage.booked_minutes * 100.0 / open_minutes) << ','
+               << formatDecimal(static_cast<double>(usage.booked_minutes) / day_count) << ','
+               << formatDecimal(usage.booked_minutes * 7.0 / day_count) << ','
+               << (usage.booked_minutes > 0 ? stampToDate(usage.peak_day * 1440) : "") << ','
+               << usage.peak_day_minutes << ',' << usage.peak_week_minutes << '\n';
+    }
+
+    output << "\ntype,resources,idle_resources,booked_minutes,utilization_percent\n";
+    for (unsigned int t = 0; t < types.size(); t++) {
+        output << csvField(types[t].type) << ',' << types[t].resource_count << ',' << types[t].idle_count << ','
+               << types[t].booked_minutes << ','
+               << formatDecimal(types[t].booked_minutes * 100.0 / (open_minutes * types[t].resource_count)) << '\n';
+    }
+
+    output << "\nweekday";
+    for (unsigned int hour = 0; hour < 24; hour++) {
+        output << ',' << formatClock(hour * 60);
+    }
+    output << '\n';
+    for (unsigned int weekday = 0; weekday < 7; weekday++) {
+        output << WEEKDAY_NAMES[weekday];
+        for (unsigned int hour = 0; hour < 24; hour++) {
+            output << ',' << heatmap[weekday * 24 + hour];
+        }
+        output << '\n';
+    }
+
+    output << "\nslot_start,busy_minutes,busy_resources\n";
+    for (unsigned int i = 0; i < contended.size(); i++) {
+        output << stampToDate(contended[i].start_stamp) << ' ' << stampToTime(contended[i].start_stamp) << ','
+               << contended[i].busy_minutes << ',' << formatDecimal(contended[i].busy_minutes / 60.0) << '\n';
+    }
+}
+
+void UtilizationReport::writeJson(std::ostream& output) const {
+    double open_minutes = static_cast<double>(getOpenMinutes());
+
+    output << "{\"from\": \"" << stampToDate(first_day * 1440) << "\", \"to\": \""
+           << stampToDate((first_day + day_count - 1) * 1440) << "\", \"day_start\": \"" << formatClock(day_start)
+           << "\", \"day_end\": \"" << formatClock(day_end) << "\", \"days\": " << day_count
+           << ", \"booked_minutes\": " << getBookedMinutes() << ", \"idle_resources\": " << getIdleCount()
+           << ", \"resources\": [";
+    for (unsigned int i = 0; i < resources.size(); i++) {
+        const ResourceUsage& usage = resources[i];
+        output << (i > 0 ? ", " : "") << "{\"id\": " << usage.id << ", \"name\": " << jsonString(usage.name)
+               << ", \"type\": " << jsonString(usage.type) << ", \"bookings\": " << usage.bookings
+               << ", \"booked_minutes\": " << usage.booked_minutes << ", \"utilization_percent\": "
+               << formatDecimal(usage.booked_minutes * 100.0 / open_minutes) << ", \"peak_day\": "
+               << (usage.booked_minutes > 0 ? "\"" + stampToDate(usage.peak_day * 1440) + "\"" : "null")
+               << ", \"peak_day_minutes\": " << usage.peak_day_minutes
+               << ", \"peak_week_minutes\": " << usage.peak_week_minutes << "}";
+    }
+
+    output << "], \"types\": [";
+    for (unsigned int t = 0; t < types.size(); t++) {
+        output << (t > 0 ? ", " : "") << "{\"type\": " << jsonString(types[t].type)
+               << ", \"resources\": " << types[t].resource_count << ", \"idle_resources\": " << types[t].idle_count
+               << ", \"booked_minutes\": " << types[t].booked_minutes << ", \"utilization_percent\": "
+               << formatDecimal(types[t].booked_minutes * 100.0 / (open_minutes * types[t].resource_count)) << "}";
+    }
+
+    output << "], \"heatmap\": [";
+    for (unsigned int weekday = 0; weekday < 7; weekday++) {
+        output << (weekday > 0 ? ", [" : "[");
+        for (unsigned int hour = 0; hour < 24; hour++) {
+            output << (hour > 0 ? ", " : "") << heatmap[weekday * 24 + hour];
+        }
+        output << "]";
+    }
+
+    output << "], \"contended_slots\": [";
+    for (unsigned int i = 0; i < contended.size(); i++) {
+        output << (i > 0 ? ", " : "") << "{\"start\": \"" << stampToDate(contended[i].start_stamp) << " "
+               << stampToTime(contended[i].start_stamp) << "\", \"busy_minutes\": " << contended[i].busy_minutes << "}";
+    }
+    output << "]}\n";
+}
@@ -1,10 +1,125 @@
 #include "CampusSystem.hpp"
+#include "Server.hpp"
 #include "outils.hpp"
 #include <iostream>
 #include <exception>
 #include <cstdlib>
+#include <string>
+#include <fstream>
+#include <thread>
 
-int main() {
+int main(int argc, char** argv) {
+
+    if (argc == 3 && std::string(argv[1]) == "--convert") {
+        try {
+            CampusSystem campus_system(false);
+            return campus_system.convertStorage(argv[2]) ? 0 : 1;
+        } catch (const std::exception& e) {
+            std::cerr << "Fatal Error: " << e.what() << std::endl;
+            return 1;
+        }
+    }
+
+    if (argc == 4 && std::string(argv[1]) == "--import") {
+        try {
+            CampusSystem campus_system(false);
+            return campus_system.importCsv(argv[2], argv[3]) ? 0 : 1;
+        } catch (const std::exception& e) {
+            std::cerr << "Fatal Error: " << e.what() << std::endl;
+            return 1;
+        }
+    }
+
+    if (argc == 3 && std::string(argv[1]) == "--archive") {
+        try {
+            CampusSystem campus_system(false);
+            return campus_system.archiveEvents(argv[2]) ? 0 : 1;
+        } catch (const std::exception& e) {
+            std::cerr << "Fatal Error: " << e.what() << std::endl;
+            return 1;
+        }
+    }
+
+    if ((argc == 4 || argc == 5) && std::string(argv[1]) == "--report") {
+        try {
+            CampusSystem campus_system(false);
+            std::string error;
+            if (!campus_system.writeReport(argv[2], argv[3], argc == 5 ? argv[4] : "text", "", "", std::cout, error)) {
+                std::cerr << "Error: " << error << std::endl;
+                return 1;
+            }
+            return 0;
+        } catch (const std::exception& e) {
+            std::cerr << "Fatal Error: " << e.what() << std::endl;
+            return 1;
+        }
+    }
+
+    if (argc >= 4 && argc <= 7 && std::string(argv[1]) == "--calendar") {
+        try {
+            CampusSystem campus_system(false);
+            std::string error;
+            unsigned int resource_id = 0;
+            unsigned int page = 0;
+            if (argc >= 5 && std::string(argv[4]) != "all" && !parseUnsigned(argv[4], resource_id)) {
+                error = "Invalid resource ID '" + std::string(argv[4]) + "'.";
+            } else if (argc == 7 && !parseUnsigned(argv[6], page)) {
+                error = "Invalid page number '" + std::string(argv[6]) + "'.";
+            }
+            if (!error.empty() || !campus_system.writeCalendar(argv[2], argv[3], resource_id,
+                                                               argc >= 6 ? argv[5] : "text", page, std::cout,
+                                                               error)) {
+                std::cerr << "Error: " << error << std::endl;
+                return 1;
+            }
+            std::cout.flush();
+            return 0;
+        } catch (const std::exception& e) {
+            std::cerr << "Fatal Error: " << e.what() << std::endl;
+            return 1;
+        }
+    }
+
+    if ((argc == 2 || argc == 3) && std::string(argv[1]) == "--serve") {
+        try {
+            CampusSystem campus_system(false);
+            Server server(campus_system, argc == 3 ? argv[2] : "campus.sock", std::thread::hardware_concurrency());
+            std::string error;
+            
+            if (!server.start(error)) {
+                std::cerr << "Error: " << error << std::endl;
+                return 1;
+            }
+            std::cout << "Listening on " << server.getSocketPath() << " (Ctrl+C to stop)" << std::endl;
+            server.run();
+            std::cout << "Server stopped, saving data..." << std::endl;
+            return 0;
+        } catch (const std::exception& e) {
+            std::cerr << "Fatal Error: " << e.what() << std::endl;
+            return 1;
+        }
+    }
+
+    if ((argc == 2 || argc == 3) && std::string(argv[1]) == "--batch") {
+        try {
+            std::ios::sync_with_stdio(false);
+            CampusSystem campus_system(false);
+            
+            if (argc == 2 || std::string(argv[2]) == "-") {
+                return campus_system.runBatch(std::cin, std::cout) == 0 ? 0 : 1;
+            }
+            
+            std::ifstream commands(argv[2]);
+            if (!commands.is_open()) {
+                std::cerr << "Error: Cannot open command file '" << argv[2] << "'" << std::endl;
+                return 1;
+            }
+            return campus_system.runBatch(commands, std::cout) == 0 ? 0 : 1;
+        } catch (const std::exception& e) {
+            std::cerr << "Fatal Error: " << e.what() << std::endl;
+            return 1;
+        }
+    }
 
     SystemStart();
     
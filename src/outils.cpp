@@ -1,6 +1,34 @@
 #include "outils.hpp"
 #include <thread>
 #include <chrono>
+#include <charconv>
+#include <vector>
+#include <algorithm>
+
+char foldCase(char c) {
+    return (c >= 'A' && c <= 'Z') ? c + 32 : c;
+}
+
+std::size_t CaseInsensitiveHash::operator()(const std::string& str) const {
+    std::size_t hash = 14695981039346656037ULL;
+    for (unsigned int i = 0; i < str.length(); i++) {
+        hash ^= static_cast<unsigned char>(foldCase(str[i]));
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+bool CaseInsensitiveEqual::operator()(const std::string& left, const std::string& right) const {
+    if (left.length() != right.length()) {
+        return false;
+    }
+    for (unsigned int i = 0; i < left.length(); i++) {
+        if (foldCase(left[i]) != foldCase(right[i])) {
+            return false;
+        }
+    }
+    return true;
+}
 
 void clearScreen() {
     #ifdef _WIN32
@@ -14,6 +42,125 @@ void sleepSeconds(int seconds) {
     std::this_thread::sleep_for(std::chrono::seconds(seconds));
 }
 
+long daysFromCivil(int year, int month, int day) {
+    year -= month <= 2;
+    long era = (year >= 0 ? year : year - 399) / 400;
+    long year_of_era = year - era * 400;
+    long day_of_year = (153 * (month + (month > 2 ? -3 : 9)) + 2) / 5 + day - 1;
+    long day_of_era = year_of_era * 365 + year_of_era / 4 - year_of_era / 100 + day_of_year;
+    return era * 146097 + day_of_era - 719468;
+}
+
+void civilFromDays(long days, int& year, int& month, int& day) {
+    days += 719468;
+    long era = (days >= 0 ? days : days - 146096) / 146097;
+    long day_of_era = days - era * 146097;
+    long year_of_era = (day_of_era - day_of_era / 1460 + day_of_era / 36524 - day_of_era / 146096) / 365;
+    long day_of_year = day_of_era - (365 * year_of_era + year_of_era / 4 - year_of_era / 100);
+    long month_index = (5 * day_of_year + 2) / 153;
+    
+    day = day_of_year - (153 * month_index + 2) / 5 + 1;
+    month = month_index < 10 ? month_index + 3 : month_index - 9;
+    year = year_of_era + era * 400 + (month <= 2);
+}
+
+long toMinuteStamp(std::string_view date, std::string_view time) {
+    if (date.length() != 10 || time.length() != 5) {
+        return 0;
+    }
+    
+    int year = (date[0] - '0') * 1000 + (date[1] - '0') * 100 + (date[2] - '0') * 10 + (date[3] - '0');
+    int month = (date[5] - '0') * 10 + (date[6] - '0');
+    int day = (date[8] - '0') * 10 + (date[9] - '0');
+    int hours = (time[0] - '0') * 10 + (time[1] - '0');
+    int minutes = (time[3] - '0') * 10 + (time[4] - '0');
+    
+    return daysFromCivil(year, month, day) * 1440 + hours * 60 + minutes;
+}
+
+std::string stampToDate(long stamp) {
+    long days = stamp >= 0 ? stamp / 1440 : (stamp - 1439) / 1440;
+    int year, month, day;
+    civilFromDays(days, year, month, day);
+    
+    std::string result = "0000-00-00";
+    result[0] = '0' + (year / 1000) % 10;
+    result[1] = '0' + (year / 100) % 10;
+    result[2] = '0' + (year / 10) % 10;
+    result[3] = '0' + year % 10;
+    result[5] = '0' + month / 10;
+    result[6] = '0' + month % 10;
+    result[8] = '0' + day / 10;
+    result[9] = '0' + day % 10;
+    return result;
+}
+
+std::string stampToTime(long stamp) {
+    int minute_of_day = ((stamp % 1440) + 1440) % 1440;
+    int hours = minute_of_day / 60;
+    int minutes = minute_of_day % 60;
+    
+    std::string result = "00:00";
+    result[0] = '0' + hours / 10;
+    result[1] = '0' + hours % 10;
+    result[3] = '0' + minutes / 10;
+    result[4] = '0' + minutes % 10;
+    return result;
+}
+
+unsigned int splitFields(std::string_view line, char delimiter, std::string_view* fields, unsigned int max_fields) {
+    unsigned int count = 0;
+    std::string_view::size_type field_start = 0;
+    
+    while (field_start < line.size()) {
+        std::string_view::size_type field_end = line.find(delimiter, field_start);
+        if (field_end == std::string_view::npos) {
+            field_end = line.size();
+        }
+        if (count == max_fields) {
+            return max_fields + 1;
+        }
+        fields[count++] = line.substr(field_start, field_end - field_start);
+        field_start = field_end + 1;
+    }
+    return count;
+}
+
+bool parseUnsigned(std::string_view text, unsigned int& value) {
+    std::from_chars_result result = std::from_chars(text.data(), text.data() + text.size(), value);
+    return result.ec == std::errc() && result.ptr == text.data() + text.size();
+}
+
+bool parseInt(std::string_view text, int& value) {
+    std::from_chars_result result = std::from_chars(text.data(), text.data() + text.size(), value);
+    return result.ec == std::errc() && result.ptr == text.data() + text.size();
+}
+
+void appendJsonString(std::string& output, std::string_view text) {
+    static const char* const HEX_DIGITS = "0123456789abcdef";
+    output += '"';
+    for (std::string_view::size_type i = 0; i < text.size(); i++) {
+        unsigned char c = static_cast<unsigned char>(text[i]);
+        if (c == '"' || c == '\\') {
+            output += '\\';
+            output += text[i];
+        } else if (c < 0x20) {
+            output += "\\u00";
+            output += HEX_DIGITS[c >> 4];
+            output += HEX_DIGITS[c & 0xF];
+        } else {
+            output += text[i];
+        }
+    }
+    output += '"';
+}
+
+std::string jsonString(std::string_view text) {
+    std::string quoted;
+    appendJsonString(quoted, text);
+    return quoted;
+}
+
 void SystemStart(){
     clearScreen();
     std::cout << "==================================================" << std::endl;
@@ -37,9 +184,11 @@ void systemEventMenu() {
     std::cout << "| 3 | Update Event                               |" << std::endl;
     std::cout << "| 4 | Delete Event                               |" << std::endl;
     std::cout << "| 5 | Search Events                              |" << std::endl;
-    std::cout << "| 6 | Return to Main Menu                        |" << std::endl;
+    std::cout << "| 6 | Find Free Time Slots                       |" << std::endl;
+    std::cout << "| 7 | Calendar View                              |" << std::endl;
+    std::cout << "| 8 | Return to Main Menu                        |" << std::endl;
     std::cout << "==================================================" << std::endl;
-    std::cout << std::endl <<"Please choose your option (1-6): ";
+    std::cout << std::endl <<"Please choose your option (1-8): ";
 }
 
 void systemMainMenu() {
@@ -75,9 +224,10 @@ void systemResourceMenu() {
     std::cout << "| 3 | Update Resource                            |" << std::endl;
     std::cout << "| 4 | Delete Resource                            |" << std::endl;
     std::cout << "| 5 | Search Resources                           |" << std::endl;
-    std::cout << "| 6 | Return to Main Menu                        |" << std::endl;
+    std::cout << "| 6 | View Resource Bookings                     |" << std::endl;
+    std::cout << "| 7 | Return to Main Menu                        |" << std::endl;
     std::cout << "==================================================" << std::endl;
-    std::cout << std::endl <<"Please choose your option (1-6): ";
+    std::cout << std::endl <<"Please choose your option (1-7): ";
 }
 
 void systemResourceSearchMenu() {
@@ -113,4 +263,73 @@ void systemEventSearchMenu() {
     std::cout << "| 3 | Return to Event Menu                       |" << std::endl;
     std::cout << "==================================================" << std::endl;
     std::cout << std::endl <<"Please choose your option (1-3): ";
-}
\ No newline at end of file
+}
+
+bool containsIgnoreCase(std::string_view text, std::string_view lowered_term) {
+    if (lowered_term.size() > text.size()) {
+        return false;
+    }
+    
+    std::string_view::size_type last_start = text.size() - lowered_term.size();
+    for (std::string_view::size_type start = 0; start <= last_start; start++) {
+        std::string_view::size_type i = 0;
+        while (i < lowered_term.size() && foldCase(text[start + i]) == lowered_term[i]) {
+            i++;
+        }
+        if (i == lowered_term.size()) {
+            return true;
+        }
+    }
+    return false;
+}
+
+int boundedSubstringDistance(std::string_view text, std::string_view lowered_pattern, int max_distance,
+                             std::vector<int>& rows) {
+    int pattern_length = lowered_pattern.size();
+    int outside = max_distance + 1;
+    std::vector<int>::size_type height = pattern_length + 1;
+    rows.assign(3 * height, outside);
+    int* before_previous = &rows[0];
+    int* previous = &rows[height];
+    int* current = &rows[2 * height];
+    
+    for (int i = 0; i <= pattern_length && i <= outside; i++) {
+        previous[i] = i;
+    }
+    int last_active = std::min(max_distance, pattern_length);
+    int best = (last_active == pattern_length) ? previous[pattern_length] : outside;
+    char previous_char = 0;
+    
+    for (std::string_view::size_type j = 0; j < text.size() && best > 0; j++) {
+        char text_char = foldCase(text[j]);
+        int limit = std::min(pattern_length, last_active + 1);
+        current[0] = 0;
+        last_active = 0;
+        
+        for (int i = 1; i <= limit; i++) {
+            int cost = (lowered_pattern[i - 1] == text_char) ? 0 : 1;
+            int value = std::min(std::min(previous[i] + 1, current[i - 1] + 1), previous[i - 1] + cost);
+            if (i > 1 && j > 0 && lowered_pattern[i - 1] == previous_char && lowered_pattern[i - 2] == text_char) {
+                value = std::min(value, before_previous[i - 2] + 1);
+            }
+            current[i] = std::min(value, outside);
+            if (current[i] <= max_distance) {
+                last_active = i;
+            }
+        }
+        for (int i = limit + 1; i <= pattern_length && current[i] != outside; i++) {
+            current[i] = outside;
+        }
+        
+        if (last_active == pattern_length) {
+            best = std::min(best, current[pattern_length]);
+        }
+        int* recycled = before_previous;
+        before_previous = previous;
+        previous = current;
+        current = recycled;
+        previous_char = text_char;
+    }
+    
+    return best;
+}